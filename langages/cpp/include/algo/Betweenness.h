@@ -0,0 +1,68 @@
+#ifndef BETWEENNESS_H
+#define BETWEENNESS_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Betweenness centrality of the nodes of a graph with Brandes' algorithm : for each source, a breadth-first search counts shortest paths, then the share of each node is gathered from the last nodes back to the source. Sources can be sampled to get an estimate faster, and are shared between threads</summary>
+class Betweenness{
+
+public:
+
+	/// <summary>Default constructor (all nodes are sources, seed 0, sequential)</summary>
+	Betweenness();
+
+	/// <summary>Set the number of sources</summary>
+	/// <param name="samples">Number of sources picked at random, 0 (default) for all nodes (exact centrality)</param>
+	void SetSamples(size_t samples);
+
+	/// <summary>Set the seed of the random generator picking sources</summary>
+	/// <param name="seed">Seed, the same seed picks the same sources</param>
+	void SetSeed(unsigned seed);
+
+	/// <summary>Set the number of threads sharing sources</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core, 1 (default) for a sequential computation</param>
+	void SetThreads(unsigned threadCount);
+
+	/// <summary>Compute the centrality of the nodes of a snapshot, following edge directions, each edge counting for 1</summary>
+	/// <param name="snapshot">Graph to analyse</param>
+	void Run(const CsrSnapshot& snapshot);
+
+	/// <summary>Scores getter</summary>
+	/// <returns>Number of shortest paths between two other nodes going through each node (each path between two nodes counting for 1 divided by the number of such paths), scaled up from sampled sources to all nodes</returns>
+	const std::vector<double>& GetScores();
+
+private:
+
+	/// <summary>Arrays of the search from one source, reset after each source</summary>
+	struct Workspace{
+		std::vector<int32_t> distances;		// Number of edges from the source, -1 if not reached
+		std::vector<double> pathCounts;		// Number of shortest paths from the source
+		std::vector<double> dependencies;	// Share of the node in paths from the source
+		std::vector<uint32_t> order;		// Reached nodes in order of distance
+		std::vector<double> scores;		// Sum of shares of each node
+	};
+
+	/// <summary>Add the shares of the nodes in the shortest paths from a source</summary>
+	/// <param name="snapshot">Graph to analyse</param>
+	/// <param name="source">Index of the source</param>
+	/// <param name="workspace">Arrays of the thread</param>
+	static void AddSource(const CsrSnapshot& snapshot, uint32_t source, Workspace& workspace);
+
+	/// <summary>Number of sources, 0 for all nodes</summary>
+	size_t samples;
+
+	/// <summary>Seed of the random generator picking sources</summary>
+	unsigned seed;
+
+	/// <summary>Number of threads, 0 for one per core</summary>
+	unsigned threadCount;
+
+	/// <summary>Score of each node</summary>
+	std::vector<double> scores;
+
+};
+
+#endif
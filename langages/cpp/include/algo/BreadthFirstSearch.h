@@ -0,0 +1,128 @@
+#ifndef BREADTH_FIRST_SEARCH_H
+#define BREADTH_FIRST_SEARCH_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <atomic>
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Breadth-first search following outgoing edges, direction-optimizing : small frontiers push to their successors (top-down), large frontiers are found by unvisited nodes through their incoming edges (bottom-up)</summary>
+class BreadthFirstSearch{
+
+public:
+
+	/// <summary>Distance and parent of a node which has not been reached</summary>
+	static const uint32_t UNREACHED = 0xFFFFFFFF;
+
+	/// <summary>Default constructor (alpha 15, beta 18, sequential)</summary>
+	BreadthFirstSearch();
+
+	/// <summary>Set when to switch to bottom-up : when edges from the frontier are more than edges to check from unvisited nodes divided by alpha</summary>
+	/// <param name="alpha">Greater values switch earlier</param>
+	void SetAlpha(unsigned alpha);
+
+	/// <summary>Set when to switch back to top-down : when the frontier is smaller than all nodes divided by beta</summary>
+	/// <param name="beta">Greater values switch later</param>
+	void SetBeta(unsigned beta);
+
+	/// <summary>Set the number of threads expanding frontiers (the result is the same whatever the number of threads)</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core, 1 (default) for a sequential search</param>
+	void SetThreads(unsigned threadCount);
+
+	/// <summary>Search from one node</summary>
+	/// <param name="snapshot">Graph to search</param>
+	/// <param name="source">Index of the first node in the snapshot</param>
+	void Run(const CsrSnapshot& snapshot, size_t source);
+
+	/// <summary>Search from several nodes at once (distances are the ones to the nearest source)</summary>
+	/// <param name="snapshot">Graph to search</param>
+	/// <param name="sources">Indexes of the first nodes in the snapshot</param>
+	void Run(const CsrSnapshot& snapshot, const std::vector<size_t>& sources);
+
+	/// <summary>Distances getter</summary>
+	/// <returns>Number of edges from the nearest source to each node, UNREACHED if there is no path</returns>
+	const std::vector<uint32_t>& GetDistances();
+
+	/// <summary>Parents getter</summary>
+	/// <returns>Previous node of each node on a shortest path (the one with the lowest index), the node itself for a source, UNREACHED if there is no path</returns>
+	const std::vector<uint32_t>& GetParents();
+
+	/// <summary>Number of reached nodes getter</summary>
+	/// <returns>Number of nodes with a path from a source, sources included</returns>
+	size_t GetReachedCount();
+
+private:
+
+	/// <summary>Build incoming edges of each node, sorted by source index</summary>
+	/// <param name="snapshot">Graph to search</param>
+	void BuildIncoming(const CsrSnapshot& snapshot);
+
+	/// <summary>Expand a part of the frontier through outgoing edges</summary>
+	/// <param name="snapshot">Graph to search</param>
+	/// <param name="first">Position of the first frontier node to expand</param>
+	/// <param name="last">Position after the last frontier node to expand</param>
+	/// <param name="level">Distance of the frontier</param>
+	/// <param name="next">Nodes reached for the first time by this part</param>
+	void StepTopDown(const CsrSnapshot& snapshot, size_t first, size_t last, uint32_t level, std::vector<uint32_t>& next);
+
+	/// <summary>Find unvisited nodes of a range whose incoming edges come from the frontier</summary>
+	/// <param name="firstWord">First word of the bitmaps to check (64 nodes per word)</param>
+	/// <param name="lastWord">Word after the last word to check</param>
+	/// <param name="level">Distance of the frontier</param>
+	/// <param name="reached">Incremented by the number of reached nodes</param>
+	/// <param name="reachedEdges">Incremented by the number of incoming edges of reached nodes</param>
+	void StepBottomUp(size_t firstWord, size_t lastWord, uint32_t level, size_t& reached, uint64_t& reachedEdges);
+
+	/// <summary>Run a step on ranges of items, with several threads if the work is large enough</summary>
+	/// <param name="itemCount">Number of items to share</param>
+	/// <param name="work">Estimated number of edges to check</param>
+	/// <param name="step">Function called with the index of the thread, the first and the last item of its range</param>
+	void RunParallel(size_t itemCount, uint64_t work, const std::function<void(unsigned, size_t, size_t)>& step);
+
+	/// <summary>Bottom-up switching factor</summary>
+	unsigned alpha;
+
+	/// <summary>Top-down switching factor</summary>
+	unsigned beta;
+
+	/// <summary>Number of threads, 0 for one per core</summary>
+	unsigned threadCount;
+
+	/// <summary>Number of threads of the current search</summary>
+	unsigned runThreads;
+
+	/// <summary>Distance of each node</summary>
+	std::vector<uint32_t> distances;
+
+	/// <summary>Parent of each node</summary>
+	std::vector<uint32_t> parents;
+
+	/// <summary>Number of reached nodes</summary>
+	size_t reachedCount;
+
+	/// <summary>Distance of each node while searching (claimed by one thread in top-down steps)</summary>
+	std::vector<std::atomic<uint32_t> > searchDistances;
+
+	/// <summary>Parent of each node while searching (lowest parent kept in top-down steps)</summary>
+	std::vector<std::atomic<uint32_t> > searchParents;
+
+	/// <summary>Index of the first incoming edge of each node in incomingSources (NodeCount+1 values)</summary>
+	std::vector<uint64_t> incomingOffsets;
+
+	/// <summary>Source of each incoming edge, sorted by source index for each node</summary>
+	std::vector<uint32_t> incomingSources;
+
+	/// <summary>Frontier as a list of nodes (top-down steps)</summary>
+	std::vector<uint32_t> frontier;
+
+	/// <summary>Frontier as a bitmap of nodes (bottom-up steps)</summary>
+	std::vector<uint64_t> frontierBits;
+
+	/// <summary>Next frontier as a bitmap of nodes (bottom-up steps)</summary>
+	std::vector<uint64_t> nextBits;
+
+};
+
+#endif
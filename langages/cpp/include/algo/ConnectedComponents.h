@@ -0,0 +1,80 @@
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Components of a graph : weakly connected ones (edge directions ignored) with a concurrent union-find, strongly connected ones (each node reaches each other one) with an iterative Tarjan's algorithm</summary>
+class ConnectedComponents{
+
+public:
+
+	/// <summary>Default constructor (sequential)</summary>
+	ConnectedComponents();
+
+	/// <summary>Set the number of threads merging weakly connected components (the result is the same whatever the number of threads)</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core, 1 (default) for a sequential search</param>
+	void SetThreads(unsigned threadCount);
+
+	/// <summary>Find weakly connected components : each edge merges the sets of its nodes, without locks</summary>
+	/// <param name="snapshot">Graph to split</param>
+	void RunWeak(const CsrSnapshot& snapshot);
+
+	/// <summary>Find strongly connected components, with an explicit stack so deep graphs cannot overflow the call stack</summary>
+	/// <param name="snapshot">Graph to split</param>
+	void RunStrong(const CsrSnapshot& snapshot);
+
+	/// <summary>Components getter</summary>
+	/// <returns>Component of each node, from 0 to ComponentCount-1. Weak components are numbered in order of their first node ; strong components in reverse topological order (edges between components go to lower ids)</returns>
+	const std::vector<uint32_t>& GetComponents();
+
+	/// <summary>Sizes getter</summary>
+	/// <returns>Number of nodes of each component</returns>
+	const std::vector<size_t>& GetSizes();
+
+	/// <summary>ComponentCount getter</summary>
+	/// <returns>Number of components</returns>
+	size_t GetComponentCount();
+
+private:
+
+	/// <summary>Node of the explicit call stack of Tarjan's algorithm</summary>
+	struct Visit{
+		uint32_t node;
+		uint64_t edge;
+	};
+
+	/// <summary>Merge the sets of the nodes of a range with the sets of their neighbours</summary>
+	/// <param name="snapshot">Graph to split</param>
+	/// <param name="first">First node of the range</param>
+	/// <param name="last">Node after the last node of the range</param>
+	void MergeRange(const CsrSnapshot& snapshot, size_t first, size_t last);
+
+	/// <summary>Find the root of the set of a node, halving the path on the way</summary>
+	/// <param name="node">Index of the node</param>
+	/// <returns>Root of the set, which is its node with the lowest index</returns>
+	uint32_t Find(uint32_t node);
+
+	/// <summary>Merge the sets of two nodes : the root with the greater index is linked to the other one</summary>
+	/// <param name="a">Index of a node</param>
+	/// <param name="b">Index of another node</param>
+	void Union(uint32_t a, uint32_t b);
+
+	/// <summary>Number of threads, 0 for one per core</summary>
+	unsigned threadCount;
+
+	/// <summary>Component of each node</summary>
+	std::vector<uint32_t> components;
+
+	/// <summary>Size of each component</summary>
+	std::vector<size_t> sizes;
+
+	/// <summary>Parent of each node in the union-find forest (roots are their own parent)</summary>
+	std::vector<std::atomic<uint32_t> > setParents;
+
+};
+
+#endif
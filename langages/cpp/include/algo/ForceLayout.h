@@ -0,0 +1,86 @@
+#ifndef FORCE_LAYOUT_H
+#define FORCE_LAYOUT_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Force-directed placement of free nodes (Fruchterman-Reingold, repulsions approximated with a Barnes-Hut quadtree), fixed nodes keep their position</summary>
+class ForceLayout{
+
+public:
+
+	/// <summary>Default constructor (300 iterations, distance 80, theta 0.8, sequential)</summary>
+	ForceLayout();
+
+	/// <summary>Set the number of iterations (more iterations give a better layout, slower)</summary>
+	/// <param name="iterations">Number of iterations</param>
+	void SetIterations(unsigned iterations);
+
+	/// <summary>Set the ideal distance between two connected nodes</summary>
+	/// <param name="distance">Ideal distance, in the same unit as node positions</param>
+	void SetDistance(float distance);
+
+	/// <summary>Set the Barnes-Hut precision : a group of nodes is seen as one node if its size divided by its distance is lower than theta</summary>
+	/// <param name="theta">0 for exact repulsions (slow), about 1 for fast approximated ones</param>
+	void SetTheta(float theta);
+
+	/// <summary>Set the number of threads computing forces (the layout is the same whatever the number of threads)</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core, 1 (default) for a sequential computation</param>
+	void SetThreads(unsigned threadCount);
+
+	/// <summary>Compute positions of all nodes of a snapshot (edges attract their nodes whatever their direction)</summary>
+	/// <param name="snapshot">Graph to place</param>
+	/// <returns>X-position and Y-position of each node (2*NodeCount values, fixed nodes are unchanged)</returns>
+	std::vector<float> Run(const CsrSnapshot& snapshot);
+
+private:
+
+	/// <summary>Cell of the quadtree</summary>
+	struct QuadCell{
+		float x;		// Left of the cell
+		float y;		// Top of the cell
+		float size;		// Width and height of the cell
+		double sumX;		// Sum of X-positions of nodes in the cell (center of mass once the tree is built)
+		double sumY;		// Sum of Y-positions of nodes in the cell (center of mass once the tree is built)
+		float mass;		// Number of nodes in the cell
+		int32_t children;	// Index of the first of four children, -1 for a leaf
+		int32_t body;		// Node of a leaf, -1 if empty, -2 if several nodes at the same place
+	};
+
+	/// <summary>Build the quadtree of current positions</summary>
+	/// <param name="positions">Current positions</param>
+	void BuildTree(const std::vector<float>& positions);
+
+	/// <summary>Compute the displacement of consecutive nodes for one iteration</summary>
+	/// <param name="positions">Current positions</param>
+	/// <param name="first">First node</param>
+	/// <param name="last">Node after the last one</param>
+	/// <param name="displacements">Displacement of each node (2*NodeCount values), written for the given nodes only</param>
+	void ComputeForces(const std::vector<float>& positions, size_t first, size_t last, std::vector<float>& displacements);
+
+	/// <summary>Number of iterations</summary>
+	unsigned iterations;
+
+	/// <summary>Ideal distance between two connected nodes</summary>
+	float distance;
+
+	/// <summary>Barnes-Hut precision</summary>
+	float theta;
+
+	/// <summary>Number of threads, 0 for one per core</summary>
+	unsigned threadCount;
+
+	/// <summary>Quadtree of the current iteration, root first</summary>
+	std::vector<QuadCell> cells;
+
+	/// <summary>Index of the first neighbour of each node in neighbours (NodeCount+1 values)</summary>
+	std::vector<uint64_t> neighbourOffsets;
+
+	/// <summary>Neighbours of each node, through outgoing and incoming edges</summary>
+	std::vector<uint32_t> neighbours;
+
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <random>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+/// <summary>Synthetic graphs of any size, to test and benchmark at scale : each generator returns a snapshot to give to Graph::Thaw (then Graph::ExportGraphml writes it for importer benchmarks). The same seed and settings always give the same graph, whatever the platform</summary>
+class GraphGenerator{
+
+public:
+
+	/// <summary>Default constructor (seed 0, nodes in a 1000 wide square, Graph500 R-MAT probabilities, nodes not shuffled)</summary>
+	GraphGenerator();
+
+	/// <summary>Set the seed of the random generator (the generator starts again from it for each graph)</summary>
+	/// <param name="seed">Seed, the same seed gives the same graphs</param>
+	void SetSeed(uint64_t seed);
+
+	/// <summary>Set the size of the square where the grid and random geometric graphs place their nodes</summary>
+	/// <param name="areaSize">Width and height of the square</param>
+	void SetAreaSize(float areaSize);
+
+	/// <summary>Set the probabilities of the four quarters of the adjacency matrix in R-MAT graphs (the last quarter has the rest)</summary>
+	/// <param name="a">Probability of the top-left quarter (edges between low indexes)</param>
+	/// <param name="b">Probability of the top-right quarter</param>
+	/// <param name="c">Probability of the bottom-left quarter</param>
+	void SetRmatProbabilities(double a, double b, double c);
+
+	/// <summary>Number nodes in a random order, as a graph read from a file may be (neighbours are then far apart, see NodeOrder)</summary>
+	/// <param name="enabled">True to shuffle node indexes, false (default) to keep the order of generation</param>
+	void SetShuffle(bool enabled);
+
+	/// <summary>Generate an Erdos-Renyi graph : edges between nodes picked uniformly at random (without loops, an edge may be drawn twice)</summary>
+	/// <param name="nodeCount">Number of nodes</param>
+	/// <param name="edgeCount">Number of edges</param>
+	/// <returns>Snapshot of free nodes</returns>
+	CsrSnapshot ErdosRenyi(size_t nodeCount, size_t edgeCount);
+
+	/// <summary>Generate a R-MAT graph (recursive Kronecker-like matrix) : each edge goes down into a quarter of the adjacency matrix at each level, so degrees are skewed and communities nested</summary>
+	/// <param name="scale">Number of levels, there are 2^scale nodes</param>
+	/// <param name="edgeCount">Number of edges (an edge may be drawn twice)</param>
+	/// <returns>Snapshot of free nodes</returns>
+	CsrSnapshot Rmat(unsigned scale, size_t edgeCount);
+
+	/// <summary>Generate a 2D grid : each node is linked both ways to its right and bottom neighbours</summary>
+	/// <param name="width">Number of columns</param>
+	/// <param name="height">Number of rows</param>
+	/// <returns>Snapshot of fixed nodes spread over the square</returns>
+	CsrSnapshot Grid(size_t width, size_t height);
+
+	/// <summary>Generate a random geometric graph : nodes are placed uniformly at random, and linked both ways when they are close</summary>
+	/// <param name="nodeCount">Number of nodes</param>
+	/// <param name="radius">Greatest distance between linked nodes, in the units of the square</param>
+	/// <returns>Snapshot of fixed nodes spread over the square</returns>
+	CsrSnapshot RandomGeometric(size_t nodeCount, float radius);
+
+	/// <summary>Generate a power-law graph by preferential attachment (Barabasi-Albert) : each new node links to existing nodes picked in proportion to their degree</summary>
+	/// <param name="nodeCount">Number of nodes</param>
+	/// <param name="edgesPerNode">Number of edges from each new node to older nodes</param>
+	/// <returns>Snapshot of free nodes</returns>
+	CsrSnapshot PowerLaw(size_t nodeCount, size_t edgesPerNode);
+
+private:
+
+	/// <summary>Draw a random integer</summary>
+	/// <param name="count">Number of possible values</param>
+	/// <returns>Integer from 0 to count-1</returns>
+	uint64_t NextIndex(uint64_t count);
+
+	/// <summary>Draw a random real number</summary>
+	/// <returns>Number from 0 (included) to 1 (excluded)</returns>
+	double NextReal();
+
+	/// <summary>Build the snapshot of a generated graph, shuffling its nodes if asked</summary>
+	/// <param name="nodeCount">Number of nodes</param>
+	/// <param name="edgeList">Source and target index of each edge</param>
+	/// <param name="coordinates">X-position and Y-position of each node, empty if all nodes are free</param>
+	/// <returns>Snapshot of the graph</returns>
+	CsrSnapshot Finish(size_t nodeCount, std::vector<std::pair<uint32_t, uint32_t> >& edgeList, std::vector<float>& coordinates);
+
+	/// <summary>Seed of the random generator</summary>
+	uint64_t seed;
+
+	/// <summary>Size of the square of positioned nodes</summary>
+	float areaSize;
+
+	/// <summary>Probabilities of the top-left, top-right and bottom-left quarters of R-MAT graphs</summary>
+	double rmatProbabilities[3];
+
+	/// <summary>If node indexes are shuffled</summary>
+	bool shuffle;
+
+	/// <summary>Random generator, whose sequence is defined by the standard (unlike the distributions of the standard library)</summary>
+	std::mt19937_64 generator;
+
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef NODE_ORDER_H
+#define NODE_ORDER_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <stdint.h>
+#include <vector>
+
+/// <summary>New order of the nodes of a graph, so neighbours get close dense indexes : snapshots frozen after a reorder (see Graph::Reorder) read their arrays with fewer cache misses. Edge directions are ignored</summary>
+class NodeOrder{
+
+public:
+
+	/// <summary>Way to order nodes</summary>
+	enum Method{
+		REVERSE_CUTHILL_MCKEE,	// Breadth-first search from a peripheral node, neighbours by increasing degree, then reversed (smallest bandwidth)
+		BREADTH_FIRST,		// Breadth-first search from the first node of each component
+		DEGREE,			// Nodes with the most edges first
+		HILBERT			// Fixed nodes along a Hilbert curve through their positions, then free nodes
+	};
+
+	/// <summary>Default constructor (reverse Cuthill-McKee)</summary>
+	NodeOrder();
+
+	/// <summary>Set the way to order nodes</summary>
+	/// <param name="method">Method used by Run</param>
+	void SetMethod(Method method);
+
+	/// <summary>Compute the new order of the nodes of a snapshot (nodes of a component are kept together by the searches, and ties keep the current order)</summary>
+	/// <param name="snapshot">Graph to order</param>
+	void Run(const CsrSnapshot& snapshot);
+
+	/// <summary>Order getter</summary>
+	/// <returns>Current index of the node at each new position</returns>
+	const std::vector<uint32_t>& GetOrder();
+
+	/// <summary>Positions getter</summary>
+	/// <returns>New position of each node, by current index</returns>
+	const std::vector<uint32_t>& GetPositions();
+
+	/// <summary>Measure how far apart the ends of edges are, to compare orders</summary>
+	/// <param name="snapshot">Graph to measure</param>
+	/// <param name="positions">Position of each node, empty for the current order of the snapshot</param>
+	/// <returns>Average distance between the positions of the two ends of an edge</returns>
+	static double ComputeAverageGap(const CsrSnapshot& snapshot, const std::vector<uint32_t>& positions);
+
+private:
+
+	/// <summary>Build the lists of neighbours of each node, edge directions ignored</summary>
+	/// <param name="snapshot">Graph to order</param>
+	void FindNeighbours(const CsrSnapshot& snapshot);
+
+	/// <summary>Add a breadth-first search to the order</summary>
+	/// <param name="start">First node of the search</param>
+	/// <param name="byDegree">If the neighbours of each node are visited by increasing degree, else in their order</param>
+	void AddSearch(uint32_t start, bool byDegree);
+
+	/// <summary>Find a node far from the start, with few neighbours, in the component of the start (George and Liu's heuristic)</summary>
+	/// <param name="start">Any node of the component</param>
+	/// <returns>Peripheral node</returns>
+	uint32_t FindPeripheralNode(uint32_t start);
+
+	/// <summary>Order nodes along a Hilbert curve</summary>
+	/// <param name="snapshot">Graph to order</param>
+	void RunHilbert(const CsrSnapshot& snapshot);
+
+	/// <summary>Compute the distance along a Hilbert curve covering a square grid</summary>
+	/// <param name="x">Column in the grid</param>
+	/// <param name="y">Row in the grid</param>
+	/// <returns>Number of cells before this one on the curve</returns>
+	static uint64_t HilbertDistance(uint32_t x, uint32_t y);
+
+	/// <summary>Way to order nodes</summary>
+	Method method;
+
+	/// <summary>Index of the first neighbour of each node</summary>
+	std::vector<uint64_t> neighbourOffsets;
+
+	/// <summary>Neighbours of each node, by outgoing and incoming edges</summary>
+	std::vector<uint32_t> neighbours;
+
+	/// <summary>Current index of the node at each new position</summary>
+	std::vector<uint32_t> order;
+
+	/// <summary>New position of each node</summary>
+	std::vector<uint32_t> positions;
+
+	/// <summary>If each node has been added to the order</summary>
+	std::vector<bool> ordered;
+
+};
+
+#endif
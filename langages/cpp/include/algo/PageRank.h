@@ -0,0 +1,74 @@
+#ifndef PAGE_RANK_H
+#define PAGE_RANK_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>PageRank of the nodes of a graph : each node pulls the rank of the sources of its incoming edges, divided by their number of outgoing edges, until ranks do not change anymore. Ranks of nodes without outgoing edge are shared by all nodes</summary>
+class PageRank{
+
+public:
+
+	/// <summary>Default constructor (damping 0.85, tolerance 1e-6, 100 iterations at most, sequential)</summary>
+	PageRank();
+
+	/// <summary>Set the probability to follow an edge rather than to jump to any node</summary>
+	/// <param name="damping">Probability between 0 and 1</param>
+	void SetDamping(double damping);
+
+	/// <summary>Set when ranks have converged</summary>
+	/// <param name="tolerance">Sum of the changes of all ranks during an iteration below which the computation stops</param>
+	void SetTolerance(double tolerance);
+
+	/// <summary>Set the greatest number of iterations</summary>
+	/// <param name="maxIterations">Number of iterations done if ranks do not converge</param>
+	void SetMaxIterations(unsigned maxIterations);
+
+	/// <summary>Set the number of threads computing ranks (the result is the same whatever the number of threads)</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core, 1 (default) for a sequential computation</param>
+	void SetThreads(unsigned threadCount);
+
+	/// <summary>Compute the ranks of the nodes of a snapshot</summary>
+	/// <param name="snapshot">Graph to rank</param>
+	/// <returns>If ranks have converged before the greatest number of iterations</returns>
+	bool Run(const CsrSnapshot& snapshot);
+
+	/// <summary>Ranks getter</summary>
+	/// <returns>Rank of each node, their sum is 1</returns>
+	const std::vector<double>& GetRanks();
+
+	/// <summary>Iterations getter</summary>
+	/// <returns>Number of iterations done by the last computation</returns>
+	unsigned GetIterations();
+
+private:
+
+	/// <summary>Run a function on all blocks of nodes, with several threads if there are enough blocks. Sums are made by block, so they do not depend on the number of threads</summary>
+	/// <param name="blockCount">Number of blocks</param>
+	/// <param name="compute">Function called with the index of each block</param>
+	void RunBlocks(size_t blockCount, const std::function<void(size_t)>& compute);
+
+	/// <summary>Probability to follow an edge</summary>
+	double damping;
+
+	/// <summary>Sum of changes below which ranks have converged</summary>
+	double tolerance;
+
+	/// <summary>Greatest number of iterations</summary>
+	unsigned maxIterations;
+
+	/// <summary>Number of threads, 0 for one per core</summary>
+	unsigned threadCount;
+
+	/// <summary>Rank of each node</summary>
+	std::vector<double> ranks;
+
+	/// <summary>Number of iterations of the last computation</summary>
+	unsigned iterations;
+
+};
+
+#endif
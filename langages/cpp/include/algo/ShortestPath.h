@@ -0,0 +1,147 @@
+#ifndef SHORTEST_PATH_H
+#define SHORTEST_PATH_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Shortest paths following outgoing edges, with Dijkstra's algorithm on a d-ary heap or with A* guided by node positions. Arrays are kept between queries on the same snapshot : a query only resets the nodes touched by the previous one</summary>
+class ShortestPath{
+
+public:
+
+	/// <summary>Parent of a node which has not been reached</summary>
+	static const uint32_t UNREACHED = 0xFFFFFFFF;
+
+	/// <summary>Default constructor (4-ary heap, weights of the edges)</summary>
+	ShortestPath();
+
+	/// <summary>Set the number of children of each heap node</summary>
+	/// <param name="arity">Number of children, at least 2 (wider heaps are shallower but compare more children when an item goes down)</param>
+	void SetArity(unsigned arity);
+
+	/// <summary>Set how edges are weighted (used by next Prepare)</summary>
+	/// <param name="euclidean">If the weight of each edge is the distance between the positions of its nodes, else the weight of the edge (default)</param>
+	void SetEuclideanWeights(bool euclidean);
+
+	/// <summary>Compute the weights of the edges and allocate the arrays for queries on a snapshot</summary>
+	/// <param name="snapshot">Graph to search (it must not be destroyed before the last query)</param>
+	void Prepare(const CsrSnapshot& snapshot);
+
+	/// <summary>Find shortest paths from a node to all nodes (Dijkstra)</summary>
+	/// <param name="source">Index of the first node in the snapshot</param>
+	void Run(size_t source);
+
+	/// <summary>Find a shortest path between two nodes (Dijkstra stopped when the target is reached)</summary>
+	/// <param name="source">Index of the first node in the snapshot</param>
+	/// <param name="target">Index of the last node in the snapshot</param>
+	/// <returns>If there is a path</returns>
+	bool Run(size_t source, size_t target);
+
+	/// <summary>Find a shortest path between two nodes (A*), exploring first nodes which are closer to the target. The heuristic is the straight distance to the target, scaled down to the smallest weight per unit of length of all edges, so it never overestimates the rest of the path. It is Dijkstra if a node has no fixed position</summary>
+	/// <param name="source">Index of the first node in the snapshot</param>
+	/// <param name="target">Index of the last node in the snapshot</param>
+	/// <returns>If there is a path</returns>
+	bool RunAStar(size_t source, size_t target);
+
+	/// <summary>Distances getter</summary>
+	/// <returns>Sum of weights of the shortest path from the source to each node, infinity if no path has been found. When the search stops at a target, only distances up to the one of the target are final</returns>
+	const std::vector<double>& GetDistances();
+
+	/// <summary>Parents getter</summary>
+	/// <returns>Previous node of each node on its path, the node itself for the source, UNREACHED if no path has been found</returns>
+	const std::vector<uint32_t>& GetParents();
+
+	/// <summary>Get the path found to a node</summary>
+	/// <param name="target">Index of the last node in the snapshot</param>
+	/// <returns>Indexes of the nodes of the path, from the source to the target (empty if no path has been found)</returns>
+	std::vector<uint32_t> GetPath(size_t target);
+
+	/// <summary>Number of settled nodes getter</summary>
+	/// <returns>Number of nodes whose edges have been followed by the last query</returns>
+	size_t GetSettledCount();
+
+private:
+
+	/// <summary>Item of the heap</summary>
+	struct HeapItem{
+		double key;
+		uint32_t node;
+	};
+
+	/// <summary>Position of a node which is not in the heap</summary>
+	static const uint32_t NOT_IN_HEAP = 0xFFFFFFFF;
+
+	/// <summary>Position of a node which has left the heap : its distance is final</summary>
+	static const uint32_t SETTLED = 0xFFFFFFFE;
+
+	/// <summary>Run a query</summary>
+	/// <param name="source">Index of the first node</param>
+	/// <param name="target">Index of the node where to stop, or the number of nodes to reach all nodes</param>
+	/// <param name="guided">If the heuristic is added to the keys of the heap</param>
+	/// <returns>If the target has been reached (always true without target)</returns>
+	bool Search(size_t source, size_t target, bool guided);
+
+	/// <summary>Reset the nodes touched by the previous query</summary>
+	void Reset();
+
+	/// <summary>Insert a node in the heap, or decrease its key if it is already in</summary>
+	/// <param name="node">Index of the node</param>
+	/// <param name="key">New key of the node</param>
+	void Push(uint32_t node, double key);
+
+	/// <summary>Remove the node with the lowest key from the heap</summary>
+	/// <returns>Index of the node</returns>
+	uint32_t Pop();
+
+	/// <summary>Move an item up until its parent has a lower key</summary>
+	/// <param name="position">Position of the item in the heap</param>
+	void SiftUp(size_t position);
+
+	/// <summary>Move an item down until its children have greater keys</summary>
+	/// <param name="position">Position of the item in the heap</param>
+	void SiftDown(size_t position);
+
+	/// <summary>Estimate the rest of a path</summary>
+	/// <param name="node">Index of a node</param>
+	/// <param name="target">Index of the target</param>
+	/// <returns>Lower bound of the distance from the node to the target</returns>
+	double Heuristic(uint32_t node, size_t target);
+
+	/// <summary>Number of children of each heap node</summary>
+	unsigned arity;
+
+	/// <summary>If weights are distances between positions</summary>
+	bool euclidean;
+
+	/// <summary>Searched graph</summary>
+	const CsrSnapshot* snapshot;
+
+	/// <summary>Weight of each edge</summary>
+	std::vector<float> weights;
+
+	/// <summary>Smallest weight per unit of length of edges, 0 if positions cannot guide the search</summary>
+	double heuristicScale;
+
+	/// <summary>Distance of each node</summary>
+	std::vector<double> distances;
+
+	/// <summary>Parent of each node</summary>
+	std::vector<uint32_t> parents;
+
+	/// <summary>Position of each node in the heap (or NOT_IN_HEAP, SETTLED)</summary>
+	std::vector<uint32_t> heapPositions;
+
+	/// <summary>Nodes waiting to be settled, the lowest key first</summary>
+	std::vector<HeapItem> heap;
+
+	/// <summary>Nodes reached by the current query</summary>
+	std::vector<uint32_t> touched;
+
+	/// <summary>Number of settled nodes</summary>
+	size_t settledCount;
+
+};
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef TIMING_ANALYSIS_H
+#define TIMING_ANALYSIS_H
+
+#include "TopologicalOrder.h"
+#include "../model/CsrSnapshot.h"
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Static timing analysis of a directed acyclic graph whose edge weights are delays : arrival time of each node (latest path from a node without incoming edge), required time (latest start which does not delay the end), slack and critical path. Levels are computed in parallel, and a few changed delays are propagated without computing everything again</summary>
+class TimingAnalysis{
+
+public:
+
+	/// <summary>Edge of a node without critical incoming edge</summary>
+	static const uint64_t NO_EDGE = 0xFFFFFFFFFFFFFFFFull;
+
+	/// <summary>Default constructor (sequential, required time is the latest arrival time)</summary>
+	TimingAnalysis();
+
+	/// <summary>Set the number of threads computing a level</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core, 1 (default) for a sequential analysis</param>
+	void SetThreads(unsigned threadCount);
+
+	/// <summary>Set the required time of nodes without outgoing edge (used by next Run or Update)</summary>
+	/// <param name="requiredTime">Required time, negative (default) for the latest arrival time, so the critical path has a slack of 0</param>
+	void SetRequiredTime(double requiredTime);
+
+	/// <summary>Analyse a snapshot with the weights of its edges as delays</summary>
+	/// <param name="snapshot">Graph to analyse (it must not be destroyed before the last Update)</param>
+	/// <returns>If the graph has no cycle (else a cycle is printed and nothing is computed)</returns>
+	bool Run(const CsrSnapshot& snapshot);
+
+	/// <summary>Change the delay of an edge, taken into account by next Update</summary>
+	/// <param name="edge">Index of the edge in the snapshot</param>
+	/// <param name="delay">New delay (must not be negative)</param>
+	void SetDelay(size_t edge, float delay);
+
+	/// <summary>Compute again the times depending on changed delays : only nodes after a changed edge get a new arrival time, only nodes before it a new required time</summary>
+	void Update();
+
+	/// <summary>ArrivalTimes getter</summary>
+	/// <returns>Latest arrival time of each node</returns>
+	const std::vector<double>& GetArrivalTimes();
+
+	/// <summary>RequiredTimes getter</summary>
+	/// <returns>Required time of each node</returns>
+	const std::vector<double>& GetRequiredTimes();
+
+	/// <summary>Get the slack of each node</summary>
+	/// <returns>Required time minus arrival time of each node (negative if the required time is too short)</returns>
+	std::vector<double> GetSlacks();
+
+	/// <summary>CriticalDelay getter</summary>
+	/// <returns>Latest arrival time of all nodes</returns>
+	double GetCriticalDelay();
+
+	/// <summary>Get the critical path</summary>
+	/// <returns>Nodes of the path ending at the latest arrival time, from its first node to its last one</returns>
+	std::vector<uint32_t> GetCriticalPath();
+
+	/// <summary>UpdatedCount getter</summary>
+	/// <returns>Number of nodes whose times have been computed again by the last Update</returns>
+	size_t GetUpdatedCount();
+
+private:
+
+	/// <summary>Compute the arrival time of a node from its incoming edges</summary>
+	/// <param name="node">Index of the node</param>
+	/// <returns>If the arrival time has changed</returns>
+	bool ComputeArrival(uint32_t node);
+
+	/// <summary>Compute the required time of a node from its outgoing edges</summary>
+	/// <param name="node">Index of the node</param>
+	/// <returns>If the required time has changed</returns>
+	bool ComputeRequired(uint32_t node);
+
+	/// <summary>Compute the arrival times of all nodes, level after level</summary>
+	void ComputeAllArrivals();
+
+	/// <summary>Compute the required times of all nodes, level after level from the last one</summary>
+	void ComputeAllRequired();
+
+	/// <summary>Find the latest arrival time among nodes without outgoing edge</summary>
+	void FindCriticalEnd();
+
+	/// <summary>Run a function on the nodes of a level, with several threads if the level is large enough</summary>
+	/// <param name="level">Index of the level</param>
+	/// <param name="compute">Function called for each node of the level</param>
+	void ComputeLevel(size_t level, const std::function<void(uint32_t)>& compute);
+
+	/// <summary>Number of threads, 0 for one per core</summary>
+	unsigned threadCount;
+
+	/// <summary>Required time of nodes without outgoing edge, negative for the latest arrival time</summary>
+	double requiredTime;
+
+	/// <summary>Analysed graph</summary>
+	const CsrSnapshot* snapshot;
+
+	/// <summary>Order of the nodes</summary>
+	TopologicalOrder order;
+
+	/// <summary>Position of each node in the order</summary>
+	std::vector<uint32_t> positions;
+
+	/// <summary>Delay of each edge</summary>
+	std::vector<float> delays;
+
+	/// <summary>Source node of each edge</summary>
+	std::vector<uint32_t> sources;
+
+	/// <summary>Index of the first incoming edge of each node in incomingEdges (NodeCount+1 values)</summary>
+	std::vector<uint64_t> incomingOffsets;
+
+	/// <summary>Index of each incoming edge in the snapshot, sorted by source index for each node</summary>
+	std::vector<uint64_t> incomingEdges;
+
+	/// <summary>Arrival time of each node</summary>
+	std::vector<double> arrivals;
+
+	/// <summary>Required time of each node</summary>
+	std::vector<double> required;
+
+	/// <summary>Incoming edge giving the arrival time of each node (NO_EDGE for nodes without incoming edge)</summary>
+	std::vector<uint64_t> criticalEdges;
+
+	/// <summary>Nodes without outgoing edge</summary>
+	std::vector<uint32_t> ends;
+
+	/// <summary>If each node is waiting in the queue of Update</summary>
+	std::vector<uint8_t> queued;
+
+	/// <summary>Node with the latest arrival time among nodes without outgoing edge</summary>
+	uint32_t criticalEnd;
+
+	/// <summary>Required time used for nodes without outgoing edge</summary>
+	double endRequiredTime;
+
+	/// <summary>Edges whose delay has changed since the last computation</summary>
+	std::vector<uint64_t> changedEdges;
+
+	/// <summary>Number of nodes computed again by the last Update</summary>
+	size_t updatedCount;
+
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef TOPOLOGICAL_ORDER_H
+#define TOPOLOGICAL_ORDER_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Topological order of a graph with Kahn's algorithm (each node comes after all the sources of its incoming edges), grouped by level, with a cycle reported when there is no such order</summary>
+class TopologicalOrder{
+
+public:
+
+	/// <summary>Level of a node which cannot be ordered (it is on a cycle or after one)</summary>
+	static const uint32_t UNORDERED = 0xFFFFFFFF;
+
+	/// <summary>Default constructor (empty order)</summary>
+	TopologicalOrder();
+
+	/// <summary>Order the nodes of a snapshot</summary>
+	/// <param name="snapshot">Graph to order</param>
+	/// <returns>If all nodes have been ordered (else the graph has a cycle, see GetCycle)</returns>
+	bool Run(const CsrSnapshot& snapshot);
+
+	/// <summary>Order getter</summary>
+	/// <returns>Nodes in topological order, level by level (nodes which cannot be ordered are missing)</returns>
+	const std::vector<uint32_t>& GetOrder();
+
+	/// <summary>Levels getter</summary>
+	/// <returns>Number of edges of the longest path from a node without incoming edge to each node, UNORDERED if the node cannot be ordered</returns>
+	const std::vector<uint32_t>& GetLevels();
+
+	/// <summary>LevelOffsets getter</summary>
+	/// <returns>Position in the order of the first node of each level (LevelCount+1 values) : nodes of a level have no edge between them</returns>
+	const std::vector<size_t>& GetLevelOffsets();
+
+	/// <summary>Cycle getter</summary>
+	/// <returns>Nodes of a cycle following edge directions, the last one having an edge to the first one (empty if all nodes have been ordered)</returns>
+	const std::vector<uint32_t>& GetCycle();
+
+private:
+
+	/// <summary>Find a cycle among the nodes which cannot be ordered, going back through incoming edges</summary>
+	/// <param name="snapshot">Ordered graph</param>
+	void FindCycle(const CsrSnapshot& snapshot);
+
+	/// <summary>Nodes in topological order</summary>
+	std::vector<uint32_t> order;
+
+	/// <summary>Level of each node</summary>
+	std::vector<uint32_t> levels;
+
+	/// <summary>Position of the first node of each level</summary>
+	std::vector<size_t> levelOffsets;
+
+	/// <summary>Nodes of a cycle</summary>
+	std::vector<uint32_t> cycle;
+
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef BINARY_FORMAT_H
+#define BINARY_FORMAT_H
+
+#include "../model/CsrSnapshot.h"
+
+#include <stdint.h>
+#include <string>
+
+class Graph;
+
+/// <summary>Native binary snapshot of a graph. All values are little-endian.
+/// Header (32 bytes) : magic "LIEGEBIN", uint32 version, uint32 number of sections, uint64 number of nodes, uint64 number of edges.
+/// Then a table of sections (24 bytes each) : uint32 tag, uint32 reserved, uint64 offset from the start of the file, uint64 size in bytes.
+/// Each section starts on a 8-bytes boundary. Unknown sections are ignored by the reader, so new sections can be added without breaking older readers.</summary>
+class BinaryFormat{
+
+public:
+
+	/// <summary>Version of the format written by Save</summary>
+	static const uint32_t VERSION = 1;
+
+	/// <summary>Write a snapshot to a binary file</summary>
+	/// <param name="snapshot">The snapshot to write</param>
+	/// <param name="path">Path of the binary file to write</param>
+	/// <returns>If the file has been entirely written</returns>
+	static bool Save(const CsrSnapshot& snapshot, std::string path);
+
+	/// <summary>Read a binary file (through a memory mapping) and add its nodes and edges to a graph</summary>
+	/// <param name="path">Path of the binary file to read</param>
+	/// <param name="graph">Graph receiving the nodes and edges</param>
+	/// <returns>If the file is valid (if not, nothing has been added to the graph)</returns>
+	static bool Load(std::string path, Graph& graph);
+
+};
+
+#endif
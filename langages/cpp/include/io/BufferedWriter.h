@@ -0,0 +1,113 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <stddef.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// <summary>Output buffer written to a file descriptor in large blocks, or kept in memory if no file is opened</summary>
+class BufferedWriter{
+
+public:
+
+	/// <summary>Size of the buffer before it is written to the file</summary>
+	static const size_t BUFFER_SIZE = 1 << 20;
+
+	/// <summary>Default constructor (in-memory buffer)</summary>
+	BufferedWriter();
+
+	/// <summary>Destructor : flush and close the file if needed</summary>
+	virtual ~BufferedWriter();
+
+	/// <summary>Create or truncate a file and write into it from now on</summary>
+	/// <param name="path">Path of the file to write</param>
+	/// <returns>If the file has been opened</returns>
+	bool Open(std::string path);
+
+	/// <summary>Write into an already opened file descriptor from now on (it will not be closed by this writer)</summary>
+	/// <param name="fd">File descriptor to write</param>
+	void Attach(int fd);
+
+	/// <summary>Flush the buffer and close the file</summary>
+	/// <returns>If everything has been written</returns>
+	bool Close();
+
+	/// <summary>Write the buffer to the file (nothing to do for an in-memory buffer)</summary>
+	/// <returns>If everything has been written</returns>
+	bool Flush();
+
+	/// <summary>Append raw bytes</summary>
+	/// <param name="text">Bytes to append</param>
+	void Write(std::string_view text);
+
+	/// <summary>Append a character</summary>
+	/// <param name="c">Character to append</param>
+	void Write(char c);
+
+	/// <summary>Append an integer in decimal notation</summary>
+	/// <param name="value">Integer to append</param>
+	void WriteInt(long long value);
+
+	/// <summary>Append a float with the same text as the default format of std::ostream (6 significant digits)</summary>
+	/// <param name="value">Float to append</param>
+	void WriteFloat(float value);
+
+	/// <summary>Append a float with the shortest text giving back exactly the same value when read</summary>
+	/// <param name="value">Float to append</param>
+	void WriteFloatExact(float value);
+
+	/// <summary>Data getter</summary>
+	/// <returns>Bytes not written to the file yet (all bytes for an in-memory buffer)</returns>
+	const char* GetData();
+
+	/// <summary>Size getter</summary>
+	/// <returns>Number of bytes not written to the file yet</returns>
+	size_t GetSize();
+
+	/// <summary>Forget bytes not written to the file yet</summary>
+	void Reset();
+
+	/// <summary>Forget bytes not written to the file yet, and free the memory of the buffer</summary>
+	void Release();
+
+	/// <summary>IsFailed getter</summary>
+	/// <returns>If a write to the file has failed</returns>
+	bool IsFailed();
+
+private:
+
+	/// <summary>Copy is forbidden : the file would be closed twice</summary>
+	BufferedWriter(const BufferedWriter&);
+
+	/// <summary>Copy is forbidden : the file would be closed twice</summary>
+	BufferedWriter& operator=(const BufferedWriter&);
+
+	/// <summary>Make room for some bytes at the end of the buffer</summary>
+	/// <param name="count">Number of bytes to append</param>
+	/// <returns>Where to append them</returns>
+	char* Reserve(size_t count);
+
+	/// <summary>Write bytes to the file until all of them are written or an error occurs</summary>
+	/// <param name="data">First byte to write</param>
+	/// <param name="size">Number of bytes to write</param>
+	void WriteAll(const char* data, size_t size);
+
+	/// <summary>Bytes not written to the file yet</summary>
+	std::vector<char> buffer;
+
+	/// <summary>Number of used bytes in the buffer</summary>
+	size_t used;
+
+	/// <summary>File descriptor to write, -1 for an in-memory buffer</summary>
+	int fd;
+
+	/// <summary>If the file descriptor has to be closed by this writer</summary>
+	bool ownsFd;
+
+	/// <summary>If a write to the file has failed</summary>
+	bool failed;
+
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef DOT_FORMAT_H
+#define DOT_FORMAT_H
+
+#include <string>
+
+class Graph;
+
+/// <summary>Streaming reader for the DOT language, for files written by Graph::ExportDot or by Graphviz.
+/// Supported : graph and digraph, node and edge statements (with edge chains), attribute lists, default attributes of nodes and edges, subgraphs (flattened), comments.
+/// Read attributes : "label" of nodes and edges, "pos" of nodes, "dir" of edges. Other attributes and ports are ignored.</summary>
+class DotFormat{
+
+public:
+
+	/// <summary>Read a DOT file (through a memory mapping, in one pass) and add its nodes and edges to a graph</summary>
+	/// <param name="path">Path of the DOT file to read</param>
+	/// <param name="scale">Divider-scale for positions (same value as the one given to ExportDot), 0 to ignore positions</param>
+	/// <param name="graph">Graph receiving the nodes and edges</param>
+	/// <returns>If the whole file has been read (on a syntax error, what has been read before is kept in the graph)</returns>
+	static bool Load(std::string path, float scale, Graph& graph);
+
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef DOT_PATCH_FILE_H
+#define DOT_PATCH_FILE_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/// <summary>DOT file patched in place : each node owns a block (its node statement and its outgoing edge statements) padded with spaces, so a changed node is rewritten without touching the rest of the file</summary>
+class DotPatchFile{
+
+public:
+
+	/// <summary>Default constructor (no file)</summary>
+	DotPatchFile();
+
+	/// <summary>Destructor : close the file if a patch has not been finished</summary>
+	~DotPatchFile();
+
+	/// <summary>Reopen the file written by the last patch to modify some blocks</summary>
+	/// <param name="path">Path of DOT file to patch</param>
+	/// <param name="scale">Multiplier-scale for positions used in the blocks</param>
+	/// <returns>If the file can be patched : false if it is another file or scale, if the file has been modified since, or if more than half of it is blank (the file has to be created again)</returns>
+	bool Resume(std::string path, float scale);
+
+	/// <summary>Create the file with an empty graph : all blocks have to be written</summary>
+	/// <param name="path">Path of DOT file to write</param>
+	/// <param name="scale">Multiplier-scale for positions used in the blocks</param>
+	/// <returns>If the file has been opened</returns>
+	bool Create(std::string path, float scale);
+
+	/// <summary>Write the block of a node : in its previous place if it fits, else at the end of the graph</summary>
+	/// <param name="id">Unique index of the node in the DOT text</param>
+	/// <param name="text">Node statement and outgoing edge statements, ending with a new line</param>
+	void WriteBlock(long long id, std::string_view text);
+
+	/// <summary>Blank the block of a deleted node</summary>
+	/// <param name="id">Unique index of the node in the DOT text</param>
+	void EraseBlock(long long id);
+
+	/// <summary>Write the closing of the graph and close the file</summary>
+	/// <returns>If all blocks have been written</returns>
+	bool Finish();
+
+	/// <summary>Forget the file : next patch will create it again</summary>
+	void Forget();
+
+	/// <summary>Check if a file has been written by this object</summary>
+	/// <returns>If blocks are known, so deleted nodes have to be erased</returns>
+	bool IsStarted();
+
+private:
+
+	/// <summary>Place of a block in the file</summary>
+	struct Block{
+		unsigned long long offset;
+		size_t capacity;
+	};
+
+	/// <summary>Size of appended text kept in memory before being written</summary>
+	static const size_t BUFFER_SIZE = 1 << 20;
+
+	/// <summary>Append a block before the closing of the graph</summary>
+	/// <param name="id">Unique index of the node in the DOT text</param>
+	/// <param name="text">Node statement and outgoing edge statements</param>
+	void Append(long long id, std::string_view text);
+
+	/// <summary>Write text at the current end of the file</summary>
+	/// <param name="text">Text to write</param>
+	void WriteAll(std::string_view text);
+
+	/// <summary>Overwrite the place of a block with text padded by spaces</summary>
+	/// <param name="block">Place to overwrite</param>
+	/// <param name="text">Text to write, shorter than the capacity of the block (empty to blank the block)</param>
+	void Overwrite(const Block& block, std::string_view text);
+
+	/// <summary>Places of the blocks, key is the unique index of the node</summary>
+	std::unordered_map<long long, Block> blocks;
+
+	/// <summary>Path of the patched file (empty if none)</summary>
+	std::string path;
+
+	/// <summary>Multiplier-scale for positions used in the blocks</summary>
+	float scale;
+
+	/// <summary>Offset of the closing of the graph, where new blocks are appended</summary>
+	unsigned long long end;
+
+	/// <summary>Size of the file after the last patch</summary>
+	unsigned long long fileSize;
+
+	/// <summary>Modification time of the file after the last patch (seconds)</summary>
+	long long modifiedSec;
+
+	/// <summary>Modification time of the file after the last patch (nanoseconds in the second)</summary>
+	long long modifiedNsec;
+
+	/// <summary>Bytes of the blocks which are used</summary>
+	unsigned long long liveBytes;
+
+	/// <summary>Bytes of blanked blocks</summary>
+	unsigned long long deadBytes;
+
+	/// <summary>Descriptor of the file while patching, -1 else (so a copied graph does not share it)</summary>
+	int fd;
+
+	/// <summary>Appended text not written to the file yet</summary>
+	std::string pending;
+
+	/// <summary>Text of a block with its padding</summary>
+	std::string padded;
+
+	/// <summary>If a write has failed during this patch</summary>
+	bool failed;
+
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef DOT_WRITER_H
+#define DOT_WRITER_H
+
+#include "BufferedWriter.h"
+
+/// <summary>Buffered writer of the DOT text produced by Graph::ExportDot (same text as Node::ToDot and Edge::ToDot, without temporary strings)</summary>
+class DotWriter : public BufferedWriter{
+
+public:
+
+	/// <summary>Write the opening of the graph</summary>
+	void WriteHeader();
+
+	/// <summary>Write the closing of the graph</summary>
+	void WriteFooter();
+
+	/// <summary>Write a node statement</summary>
+	/// <param name="i">Node index (should be unique for each node)</param>
+	/// <param name="label">Label of the node</param>
+	/// <param name="fixedPos">If X-Y-position is fixed</param>
+	/// <param name="x">X-position</param>
+	/// <param name="y">Y-position</param>
+	/// <param name="scale">Multiplier-scale for position, 0 if free position</param>
+	void WriteNode(long long i, std::string_view label, bool fixedPos, float x, float y, float scale);
+
+	/// <summary>Write an edge statement</summary>
+	/// <param name="fromIndex">Index of the source node</param>
+	/// <param name="toIndex">Index of the target node</param>
+	/// <param name="label">Label of the edge</param>
+	void WriteEdge(long long fromIndex, long long toIndex, std::string_view label);
+
+	/// <summary>Write default attributes of the edges which follow</summary>
+	/// <param name="dir">Default direction of arrows (for example "both"), empty to keep the one of Graphviz</param>
+	/// <param name="hasLabel">If a default label has to be written</param>
+	/// <param name="label">Default label of the edges</param>
+	void WriteEdgeDefaults(std::string_view dir, bool hasLabel, std::string_view label);
+
+	/// <summary>Write a node statement on one line</summary>
+	/// <param name="i">Node index (should be unique for each node)</param>
+	/// <param name="label">Label of the node</param>
+	/// <param name="fixedPos">If X-Y-position is fixed</param>
+	/// <param name="x">X-position</param>
+	/// <param name="y">Y-position</param>
+	/// <param name="scale">Multiplier-scale for position, 0 if free position</param>
+	void WriteCompactNode(long long i, std::string_view label, bool fixedPos, float x, float y, float scale);
+
+	/// <summary>Write an edge statement with only the attributes which differ from the defaults</summary>
+	/// <param name="fromIndex">Index of the source node</param>
+	/// <param name="toIndex">Index of the target node</param>
+	/// <param name="dir">Direction of arrows (for example "both"), empty for the default one</param>
+	/// <param name="hasLabel">If the label differs from the default one</param>
+	/// <param name="label">Label of the edge</param>
+	void WriteCompactEdge(long long fromIndex, long long toIndex, std::string_view dir, bool hasLabel, std::string_view label);
+
+	/// <summary>Write a DOT string content : double quotes are escaped, and so are backslashes which would escape a quote, a backslash or a line break (other Graphviz escapes such as \n are kept)</summary>
+	/// <param name="text">Text to write</param>
+	void WriteEscaped(std::string_view text);
+
+private:
+
+	/// <summary>Write the list of attributes of an edge, without brackets</summary>
+	/// <param name="dir">Direction of arrows, empty if not written</param>
+	/// <param name="hasLabel">If the label has to be written</param>
+	/// <param name="label">Label of the edge</param>
+	void WriteAttributes(std::string_view dir, bool hasLabel, std::string_view label);
+
+};
+
+#endif
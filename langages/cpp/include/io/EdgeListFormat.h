@@ -0,0 +1,25 @@
+#ifndef EDGE_LIST_FORMAT_H
+#define EDGE_LIST_FORMAT_H
+
+#include <string>
+
+class Graph;
+
+/// <summary>Plain text list of edges, one "source,target,label" line per edge (the label is optional and may contain the separator, other fields only between double quotes).
+/// Empty lines and lines starting with '#' are ignored, fields may be surrounded by spaces or double quotes (a double quote inside double quotes is written twice, like in CSV).
+/// Nodes are identified by their name : the first occurrence of a name creates a free node with this label.</summary>
+class EdgeListFormat{
+
+public:
+
+	/// <summary>Read an edge list file (through a memory mapping, parsed by several threads) and add its nodes and edges to a graph</summary>
+	/// <param name="path">Path of the edge list file to read</param>
+	/// <param name="separator">Character between fields (a separator between double quotes is part of the field)</param>
+	/// <param name="threadCount">Number of threads parsing the file, 0 for one per core</param>
+	/// <param name="graph">Graph receiving the nodes and edges</param>
+	/// <returns>If the file has been read</returns>
+	static bool Load(std::string path, char separator, unsigned threadCount, Graph& graph);
+
+};
+
+#endif
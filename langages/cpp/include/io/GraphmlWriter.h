@@ -0,0 +1,37 @@
+#ifndef GRAPHML_WRITER_H
+#define GRAPHML_WRITER_H
+
+#include "XmlWriter.h"
+
+/// <summary>Buffered writer of yEd-compatible GraphML text produced by Graph::ExportGraphml (readable by Graph::ImportGraphml)</summary>
+class GraphmlWriter : public XmlWriter{
+
+public:
+
+	/// <summary>Width and height of the shape of each node</summary>
+	static const int NODE_SIZE = 30;
+
+	/// <summary>Write the opening of the document and of the graph</summary>
+	void WriteHeader();
+
+	/// <summary>Write the closing of the graph and of the document</summary>
+	void WriteFooter();
+
+	/// <summary>Write a node with its shape, position and label</summary>
+	/// <param name="i">Node index (should be unique for each node)</param>
+	/// <param name="label">Label of the node</param>
+	/// <param name="x">X-position of the top-left corner of the shape</param>
+	/// <param name="y">Y-position of the top-left corner of the shape</param>
+	void WriteNode(long long i, std::string_view label, float x, float y);
+
+	/// <summary>Write an edge with its arrows and label</summary>
+	/// <param name="i">Edge index (should be unique for each edge)</param>
+	/// <param name="fromIndex">Index of the source node</param>
+	/// <param name="toIndex">Index of the target node</param>
+	/// <param name="label">Label of the edge</param>
+	/// <param name="isBidirectional">If there is an arrow on both sides</param>
+	void WriteEdge(long long i, long long fromIndex, long long toIndex, std::string_view label, bool isBidirectional);
+
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef GRAPHVIZ_RENDERER_H
+#define GRAPHVIZ_RENDERER_H
+
+#include <signal.h>
+#include <sys/types.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// <summary>Run of the Graphviz "dot" binary without shell, drawing all requested images in one invocation (DOT text is read from a file or from a pipe)</summary>
+class GraphvizRenderer{
+
+public:
+
+	/// <summary>Default constructor (default layout engine, no image)</summary>
+	GraphvizRenderer();
+
+	/// <summary>Destructor : wait for Graphviz if it is still running</summary>
+	~GraphvizRenderer();
+
+	/// <summary>Set the layout engine given to Graphviz with -K</summary>
+	/// <param name="engine">Name of the layout engine (for example "fdp" to keep fixed positions), empty for the default one</param>
+	void SetEngine(std::string engine);
+
+	/// <summary>Request an image (all images are drawn from the same layout)</summary>
+	/// <param name="format">Graphviz output format (for example "png" or "svg")</param>
+	/// <param name="path">Path of the image to draw</param>
+	void AddOutput(std::string format, std::string path);
+
+	/// <summary>Check if an image has been requested</summary>
+	/// <returns>If there is at least one image to draw</returns>
+	bool HasOutputs();
+
+	/// <summary>Launch Graphviz (SIGPIPE is blocked in the calling thread until Wait, which has to be called by the same thread)</summary>
+	/// <param name="pathDot">Path of the DOT file to read, empty to write DOT text into the input pipe (see GetInput)</param>
+	/// <returns>If Graphviz has been launched (the reason is given by GetErrors if not)</returns>
+	bool Start(std::string pathDot);
+
+	/// <summary>Input pipe getter</summary>
+	/// <returns>File descriptor to write DOT text into, -1 if Graphviz reads a file or is not running</returns>
+	int GetInput();
+
+	/// <summary>Close the input pipe and wait for the end of Graphviz</summary>
+	/// <returns>If Graphviz has succeeded</returns>
+	bool Wait();
+
+	/// <summary>Exit status getter</summary>
+	/// <returns>Exit status of the last run of Graphviz, -1 if it has not been launched or has been killed</returns>
+	int GetExitStatus();
+
+	/// <summary>Errors getter</summary>
+	/// <returns>Error output of the last run of Graphviz, or reason why it could not be launched</returns>
+	const std::string& GetErrors();
+
+private:
+
+	/// <summary>Copy is forbidden : the process would be waited twice</summary>
+	GraphvizRenderer(const GraphvizRenderer&);
+
+	/// <summary>Copy is forbidden : the process would be waited twice</summary>
+	GraphvizRenderer& operator=(const GraphvizRenderer&);
+
+	/// <summary>Read the error output of Graphviz until it is closed (run in its own thread, so that Graphviz never blocks on a full pipe)</summary>
+	/// <param name="fd">File descriptor of the error pipe (closed at the end)</param>
+	void ReadErrors(int fd);
+
+	/// <summary>Layout engine, empty for the default one</summary>
+	std::string engine;
+
+	/// <summary>Requested images : format and path</summary>
+	std::vector<std::pair<std::string, std::string> > outputs;
+
+	/// <summary>Process identifier of Graphviz, -1 if not running</summary>
+	pid_t pid;
+
+	/// <summary>Write side of the input pipe, -1 if none</summary>
+	int inputFd;
+
+	/// <summary>Exit status of the last run</summary>
+	int exitStatus;
+
+	/// <summary>Error output of the last run</summary>
+	std::string errors;
+
+	/// <summary>Thread reading the error output</summary>
+	std::thread errorReader;
+
+	/// <summary>Signal mask of the calling thread before Start</summary>
+	sigset_t previousMask;
+
+};
+
+#endif
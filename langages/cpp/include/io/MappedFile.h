@@ -0,0 +1,50 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <stddef.h>
+
+/// <summary>Read-only memory mapping of a whole file (unmapped on destruction)</summary>
+class MappedFile{
+
+public:
+
+	/// <summary>Default constructor (nothing mapped)</summary>
+	MappedFile();
+
+	/// <summary>Destructor : unmap the file if needed</summary>
+	~MappedFile();
+
+	/// <summary>Map a file in memory (a previously mapped file will be unmapped first)</summary>
+	/// <param name="path">Path of the file to map</param>
+	/// <returns>If the file has been mapped (an empty file is considered as mapped, with a null data pointer)</returns>
+	bool Open(std::string path);
+
+	/// <summary>Unmap the file</summary>
+	void Close();
+
+	/// <summary>Data getter</summary>
+	/// <returns>First byte of the mapped file (null if nothing is mapped or if the file is empty)</returns>
+	const char* GetData();
+
+	/// <summary>Size getter</summary>
+	/// <returns>Number of mapped bytes</returns>
+	size_t GetSize();
+
+private:
+
+	/// <summary>Copy is forbidden : the mapping would be unmapped twice</summary>
+	MappedFile(const MappedFile&);
+
+	/// <summary>Copy is forbidden : the mapping would be unmapped twice</summary>
+	MappedFile& operator=(const MappedFile&);
+
+	/// <summary>First byte of the mapped file</summary>
+	const char* data;
+
+	/// <summary>Number of mapped bytes</summary>
+	size_t size;
+
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef PNG_FORMAT_H
+#define PNG_FORMAT_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/// <summary>Minimal PNG writer : 8 bits RGBA image, rows without filter, zlib stream made of stored (uncompressed) deflate blocks, one IDAT chunk per block</summary>
+class PngFormat{
+
+public:
+
+	/// <summary>Write an image to a PNG file</summary>
+	/// <param name="pixels">Red, green, blue and alpha bytes of each pixel, row by row from the top</param>
+	/// <param name="width">Width of the image in pixels</param>
+	/// <param name="height">Height of the image in pixels</param>
+	/// <param name="path">Path of the PNG file to write</param>
+	/// <returns>If the file has been entirely written</returns>
+	static bool Save(const std::vector<uint8_t>& pixels, unsigned width, unsigned height, std::string path);
+
+	/// <summary>Compute the CRC-32 used by PNG chunks</summary>
+	/// <param name="crc">CRC of the previous bytes (0 for the first ones)</param>
+	/// <param name="data">First byte to add</param>
+	/// <param name="size">Number of bytes to add</param>
+	/// <returns>CRC of the previous bytes followed by the new ones</returns>
+	static uint32_t Crc32(uint32_t crc, const uint8_t* data, size_t size);
+
+	/// <summary>Compute the Adler-32 checksum ending a zlib stream</summary>
+	/// <param name="adler">Checksum of the previous bytes (1 for the first ones)</param>
+	/// <param name="data">First byte to add</param>
+	/// <param name="size">Number of bytes to add</param>
+	/// <returns>Checksum of the previous bytes followed by the new ones</returns>
+	static uint32_t Adler32(uint32_t adler, const uint8_t* data, size_t size);
+
+};
+
+#endif
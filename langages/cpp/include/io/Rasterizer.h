@@ -0,0 +1,165 @@
+#ifndef RASTERIZER_H
+#define RASTERIZER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Anti-aliased drawing of lines, triangles and circles into a RGBA image. Shapes are queued, then Render draws the image tile by tile (tiles are independent, so the image is the same whatever the number of threads)</summary>
+class Rasterizer{
+
+public:
+
+	/// <summary>Width and height of a tile in pixels</summary>
+	static const int TILE_SIZE = 64;
+
+	/// <summary>Color meaning "not drawn" (colors are 0xRRGGBB)</summary>
+	static const uint32_t NO_COLOR = 0xFF000000;
+
+	/// <summary>Constructor</summary>
+	/// <param name="width">Width of the image in pixels</param>
+	/// <param name="height">Height of the image in pixels</param>
+	/// <param name="background">Color of the background</param>
+	Rasterizer(unsigned width, unsigned height, uint32_t background);
+
+	/// <summary>Set the number of threads drawing tiles</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core, 1 (default) for a sequential drawing</param>
+	void SetThreads(unsigned threadCount);
+
+	/// <summary>Queue a line</summary>
+	/// <param name="x0">X-position of the first end, in pixels</param>
+	/// <param name="y0">Y-position of the first end, in pixels</param>
+	/// <param name="x1">X-position of the second end, in pixels</param>
+	/// <param name="y1">Y-position of the second end, in pixels</param>
+	/// <param name="thickness">Thickness of the line, in pixels</param>
+	/// <param name="color">Color of the line</param>
+	void DrawLine(float x0, float y0, float x1, float y1, float thickness, uint32_t color);
+
+	/// <summary>Queue a filled triangle</summary>
+	/// <param name="x0">X-position of the first corner, in pixels</param>
+	/// <param name="y0">Y-position of the first corner, in pixels</param>
+	/// <param name="x1">X-position of the second corner, in pixels</param>
+	/// <param name="y1">Y-position of the second corner, in pixels</param>
+	/// <param name="x2">X-position of the third corner, in pixels</param>
+	/// <param name="y2">Y-position of the third corner, in pixels</param>
+	/// <param name="color">Color of the triangle</param>
+	void DrawTriangle(float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color);
+
+	/// <summary>Queue a circle</summary>
+	/// <param name="x">X-position of the center, in pixels</param>
+	/// <param name="y">Y-position of the center, in pixels</param>
+	/// <param name="radius">Radius, in pixels</param>
+	/// <param name="fill">Color inside the circle, NO_COLOR for an empty circle</param>
+	/// <param name="border">Color of the 1 pixel border, NO_COLOR for no border</param>
+	void DrawCircle(float x, float y, float radius, uint32_t fill, uint32_t border);
+
+	/// <summary>Queue an arrow between the borders of two circles of the same radius (a small circle over the first one if both are at the same place)</summary>
+	/// <param name="x0">X-position of the center of the source circle, in pixels</param>
+	/// <param name="y0">Y-position of the center of the source circle, in pixels</param>
+	/// <param name="x1">X-position of the center of the target circle, in pixels</param>
+	/// <param name="y1">Y-position of the center of the target circle, in pixels</param>
+	/// <param name="radius">Radius of the circles, in pixels</param>
+	/// <param name="headSize">Length of the arrow heads, in pixels</param>
+	/// <param name="isBidirectional">If there is an arrow head on both sides</param>
+	/// <param name="color">Color of the arrow</param>
+	void DrawArrow(float x0, float y0, float x1, float y1, float radius, float headSize, bool isBidirectional, uint32_t color);
+
+	/// <summary>Draw queued shapes in their order, then forget them</summary>
+	void Render();
+
+	/// <summary>Width getter</summary>
+	/// <returns>Width of the image in pixels</returns>
+	unsigned GetWidth();
+
+	/// <summary>Height getter</summary>
+	/// <returns>Height of the image in pixels</returns>
+	unsigned GetHeight();
+
+	/// <summary>Pixels getter</summary>
+	/// <returns>Red, green, blue and alpha bytes of each pixel, row by row from the top</returns>
+	const std::vector<uint8_t>& GetPixels();
+
+private:
+
+	/// <summary>Kind of shape</summary>
+	enum ShapeType{LINE, TRIANGLE, CIRCLE};
+
+	/// <summary>Queued shape</summary>
+	struct Shape{
+		ShapeType type;
+		float points[6];	// Ends of a line, corners of a triangle, or center and radius of a circle
+		float size;		// Thickness of a line
+		uint32_t fill;		// Color of a line, a triangle or inside a circle
+		uint32_t border;	// Color of the border of a circle
+	};
+
+	/// <summary>Add a shape to the tiles it may cover</summary>
+	/// <param name="shape">The shape to add</param>
+	/// <param name="minX">Left of the shape, in pixels</param>
+	/// <param name="minY">Top of the shape, in pixels</param>
+	/// <param name="maxX">Right of the shape, in pixels</param>
+	/// <param name="maxY">Bottom of the shape, in pixels</param>
+	void Queue(const Shape& shape, float minX, float minY, float maxX, float maxY);
+
+	/// <summary>Draw the shapes of a tile</summary>
+	/// <param name="tile">Index of the tile, row by row</param>
+	void RenderTile(size_t tile);
+
+	/// <summary>Draw a line inside a rectangle of pixels</summary>
+	/// <param name="shape">The line</param>
+	/// <param name="left">First column</param>
+	/// <param name="top">First row</param>
+	/// <param name="right">Column after the last one</param>
+	/// <param name="bottom">Row after the last one</param>
+	void RenderLine(const Shape& shape, int left, int top, int right, int bottom);
+
+	/// <summary>Draw a triangle inside a rectangle of pixels</summary>
+	/// <param name="shape">The triangle</param>
+	/// <param name="left">First column</param>
+	/// <param name="top">First row</param>
+	/// <param name="right">Column after the last one</param>
+	/// <param name="bottom">Row after the last one</param>
+	void RenderTriangle(const Shape& shape, int left, int top, int right, int bottom);
+
+	/// <summary>Draw a circle inside a rectangle of pixels</summary>
+	/// <param name="shape">The circle</param>
+	/// <param name="left">First column</param>
+	/// <param name="top">First row</param>
+	/// <param name="right">Column after the last one</param>
+	/// <param name="bottom">Row after the last one</param>
+	void RenderCircle(const Shape& shape, int left, int top, int right, int bottom);
+
+	/// <summary>Mix a color into a pixel</summary>
+	/// <param name="x">Column of the pixel</param>
+	/// <param name="y">Row of the pixel</param>
+	/// <param name="color">Color to mix</param>
+	/// <param name="coverage">Part of the pixel covered by the color, from 0 to 1</param>
+	void Blend(int x, int y, uint32_t color, float coverage);
+
+	/// <summary>Width of the image in pixels</summary>
+	unsigned width;
+
+	/// <summary>Height of the image in pixels</summary>
+	unsigned height;
+
+	/// <summary>Number of tiles in a row</summary>
+	unsigned tilesX;
+
+	/// <summary>Number of tiles in a column</summary>
+	unsigned tilesY;
+
+	/// <summary>Number of threads, 0 for one per core</summary>
+	unsigned threadCount;
+
+	/// <summary>Queued shapes</summary>
+	std::vector<Shape> shapes;
+
+	/// <summary>Shapes which may cover each tile, in their order</summary>
+	std::vector<std::vector<uint32_t> > tiles;
+
+	/// <summary>Red, green, blue and alpha bytes of each pixel</summary>
+	std::vector<uint8_t> pixels;
+
+};
+
+#endif
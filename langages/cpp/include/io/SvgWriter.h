@@ -0,0 +1,78 @@
+#ifndef SVG_WRITER_H
+#define SVG_WRITER_H
+
+#include "XmlWriter.h"
+
+/// <summary>Buffered writer of SVG drawings produced by Graph::ExportSvg (positions are the ones of yEd shapes : top-left corner of a square node)</summary>
+class SvgWriter : public XmlWriter{
+
+public:
+
+	/// <summary>Width and height of each node, as in GraphML files</summary>
+	static const int NODE_SIZE = 30;
+
+	/// <summary>Write the opening of the drawing and the arrow definition</summary>
+	/// <param name="minX">Lowest X-position of nodes</param>
+	/// <param name="minY">Lowest Y-position of nodes</param>
+	/// <param name="maxX">Highest X-position of nodes</param>
+	/// <param name="maxY">Highest Y-position of nodes</param>
+	void WriteHeader(float minX, float minY, float maxX, float maxY);
+
+	/// <summary>Write the closing of the drawing</summary>
+	void WriteFooter();
+
+	/// <summary>Open the group of edges (drawn first, under nodes)</summary>
+	void BeginEdges();
+
+	/// <summary>Open the group of nodes</summary>
+	void BeginNodes();
+
+	/// <summary>Open the group of labels (drawn last, over nodes and edges)</summary>
+	void BeginLabels();
+
+	/// <summary>Close the current group</summary>
+	void EndGroup();
+
+	/// <summary>Write a node</summary>
+	/// <param name="x">X-position of the node</param>
+	/// <param name="y">Y-position of the node</param>
+	void WriteNode(float x, float y);
+
+	/// <summary>Write an edge from the border of a node to the border of another one (a loop if both nodes are at the same place)</summary>
+	/// <param name="fromX">X-position of the source node</param>
+	/// <param name="fromY">Y-position of the source node</param>
+	/// <param name="toX">X-position of the target node</param>
+	/// <param name="toY">Y-position of the target node</param>
+	/// <param name="isBidirectional">If there is an arrow on both sides</param>
+	void WriteEdge(float fromX, float fromY, float toX, float toY, bool isBidirectional);
+
+	/// <summary>Write a label centered on a node</summary>
+	/// <param name="x">X-position of the node</param>
+	/// <param name="y">Y-position of the node</param>
+	/// <param name="label">Text of the label</param>
+	void WriteNodeLabel(float x, float y, std::string_view label);
+
+	/// <summary>Write a label in the middle of an edge</summary>
+	/// <param name="fromX">X-position of the source node</param>
+	/// <param name="fromY">Y-position of the source node</param>
+	/// <param name="toX">X-position of the target node</param>
+	/// <param name="toY">Y-position of the target node</param>
+	/// <param name="label">Text of the label</param>
+	void WriteEdgeLabel(float fromX, float fromY, float toX, float toY, std::string_view label);
+
+private:
+
+	/// <summary>Write a point as "x,y"</summary>
+	/// <param name="x">X-position</param>
+	/// <param name="y">Y-position</param>
+	void WritePoint(float x, float y);
+
+	/// <summary>Write a text element</summary>
+	/// <param name="x">X-position of the center of the text</param>
+	/// <param name="y">Y-position of the center of the text</param>
+	/// <param name="label">Text to write</param>
+	void WriteText(float x, float y, std::string_view label);
+
+};
+
+#endif
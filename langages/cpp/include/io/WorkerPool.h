@@ -0,0 +1,59 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>Threads running tasks in the background, in submission order</summary>
+class WorkerPool{
+
+public:
+
+	/// <summary>Constructor : launch the threads</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core</param>
+	WorkerPool(unsigned threadCount);
+
+	/// <summary>Destructor : run remaining tasks, then stop the threads</summary>
+	~WorkerPool();
+
+	/// <summary>Queue a task, run by the first free thread</summary>
+	/// <param name="task">Task to run</param>
+	void Submit(std::function<void()> task);
+
+	/// <summary>Number of threads getter</summary>
+	/// <returns>Number of threads running tasks</returns>
+	unsigned GetThreadCount();
+
+private:
+
+	/// <summary>Copy is forbidden : threads would be joined twice</summary>
+	WorkerPool(const WorkerPool&);
+
+	/// <summary>Copy is forbidden : threads would be joined twice</summary>
+	WorkerPool& operator=(const WorkerPool&);
+
+	/// <summary>Run queued tasks until the pool is stopped and the queue is empty (loop of each thread)</summary>
+	void Work();
+
+	/// <summary>Tasks waiting for a thread</summary>
+	std::deque<std::function<void()> > tasks;
+
+	/// <summary>Threads running tasks</summary>
+	std::vector<std::thread> workers;
+
+	/// <summary>Protection of the queue and of the stop flag</summary>
+	std::mutex lock;
+
+	/// <summary>Signaled when a task is queued or when the pool stops</summary>
+	std::condition_variable wakeUp;
+
+	/// <summary>If threads have to stop once the queue is empty</summary>
+	bool stopping;
+
+};
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef XML_WRITER_H
+#define XML_WRITER_H
+
+#include "BufferedWriter.h"
+
+/// <summary>Buffered writer of XML text (base of GraphML and SVG writers)</summary>
+class XmlWriter : public BufferedWriter{
+
+public:
+
+	/// <summary>Write XML text : special characters are replaced by entities</summary>
+	/// <param name="text">Text to write</param>
+	void WriteEscaped(std::string_view text);
+
+};
+
+#endif
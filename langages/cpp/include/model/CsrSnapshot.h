@@ -0,0 +1,142 @@
+#ifndef CSR_SNAPSHOT_H
+#define CSR_SNAPSHOT_H
+
+#include "Node.h"
+#include "Edge.h"
+
+#include <functional>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// <summary>Frozen copy of a list of nodes in compressed sparse row layout : node i owns edges offsets[i] to offsets[i+1]-1</summary>
+class CsrSnapshot{
+
+	friend class BinaryFormat;
+
+public:
+
+	/// <summary>Default constructor (empty snapshot)</summary>
+	CsrSnapshot();
+
+	/// <summary>Constructor : copy labels, positions and outgoing edges of the nodes</summary>
+	/// <param name="nodes">Nodes to freeze. Edges going to a node which is not in this list are ignored</param>
+	CsrSnapshot(const std::vector<Node*>& nodes);
+
+	/// <summary>Constructor : copy labels, positions and the outgoing edges of the nodes accepted by a function</summary>
+	/// <param name="nodes">Nodes to freeze</param>
+	/// <param name="keepEdge">Function returning if an edge is copied, it must reject edges going to a node which is not in the list (empty function to copy all edges)</param>
+	CsrSnapshot(const std::vector<Node*>& nodes, const std::function<bool(Edge*)>& keepEdge);
+
+	/// <summary>Constructor : build a snapshot from a list of edges, without nodes behind it (nodes are labelled with their index, edges are unlabelled with weight 1)</summary>
+	/// <param name="nodeCount">Number of nodes</param>
+	/// <param name="edgeList">Source and target index of each edge (edges of a node keep their order in this list)</param>
+	/// <param name="coordinates">X-position and Y-position of each node, empty if all nodes are free</param>
+	CsrSnapshot(size_t nodeCount, const std::vector<std::pair<uint32_t, uint32_t> >& edgeList, const std::vector<float>& coordinates);
+
+	/// <summary>Constructor : build a snapshot from a list of labelled edges, without nodes behind it (edges have weight 1)</summary>
+	/// <param name="nodeCount">Number of nodes</param>
+	/// <param name="edgeList">Source and target index of each edge (edges of a node keep their order in this list)</param>
+	/// <param name="coordinates">X-position and Y-position of each node, empty if all nodes are free</param>
+	/// <param name="nodeLabels">Label of each node, empty to label nodes with their index</param>
+	/// <param name="edgeLabels">Label of each edge in the order of the list, empty for unlabelled edges</param>
+	CsrSnapshot(size_t nodeCount, const std::vector<std::pair<uint32_t, uint32_t> >& edgeList, const std::vector<float>& coordinates, const std::vector<std::string_view>& nodeLabels, const std::vector<std::string_view>& edgeLabels);
+
+	/// <summary>NodeCount getter</summary>
+	/// <returns>Number of nodes</returns>
+	size_t GetNodeCount() const;
+
+	/// <summary>EdgeCount getter</summary>
+	/// <returns>Number of edges</returns>
+	size_t GetEdgeCount() const;
+
+	/// <summary>Offsets getter</summary>
+	/// <returns>Index of the first outgoing edge of each node (NodeCount+1 values, the last one is EdgeCount)</returns>
+	const std::vector<uint64_t>& GetOffsets() const;
+
+	/// <summary>Targets getter</summary>
+	/// <returns>Index of the target node of each edge</returns>
+	const std::vector<uint32_t>& GetTargets() const;
+
+	/// <summary>Weights getter</summary>
+	/// <returns>Weight of each edge</returns>
+	const std::vector<float>& GetWeights() const;
+
+	/// <summary>NodeLabelOffsets getter</summary>
+	/// <returns>Position of each node label in the label pool (NodeCount+1 values)</returns>
+	const std::vector<uint64_t>& GetNodeLabelOffsets() const;
+
+	/// <summary>EdgeLabelOffsets getter</summary>
+	/// <returns>Position of each edge label in the label pool (EdgeCount+1 values)</returns>
+	const std::vector<uint64_t>& GetEdgeLabelOffsets() const;
+
+	/// <summary>LabelPool getter</summary>
+	/// <returns>Concatenation of all node labels followed by all edge labels</returns>
+	const std::string& GetLabelPool() const;
+
+	/// <summary>Coordinates getter</summary>
+	/// <returns>X-position and Y-position of each node (2*NodeCount values, 0 for free nodes)</returns>
+	const std::vector<float>& GetCoordinates() const;
+
+	/// <summary>Fixed getter</summary>
+	/// <returns>1 for each node with a fixed position, else 0</returns>
+	const std::vector<uint8_t>& GetFixed() const;
+
+	/// <summary>Node getter</summary>
+	/// <param name="i">Index of the node in this snapshot</param>
+	/// <returns>Original node (do not use it if the node has been deleted since the snapshot)</returns>
+	Node* GetNode(size_t i) const;
+
+	/// <summary>Edge getter</summary>
+	/// <param name="i">Index of the edge in this snapshot</param>
+	/// <returns>Original edge (do not use it if the edge has been deleted since the snapshot)</returns>
+	Edge* GetEdge(size_t i) const;
+
+	/// <summary>Get the label of a node</summary>
+	/// <param name="i">Index of the node</param>
+	/// <returns>Label of the node</returns>
+	std::string GetNodeLabel(size_t i) const;
+
+	/// <summary>Get the label of an edge</summary>
+	/// <param name="i">Index of the edge</param>
+	/// <returns>Label of the edge</returns>
+	std::string GetEdgeLabel(size_t i) const;
+
+private:
+
+	/// <summary>Index of the first outgoing edge of each node</summary>
+	std::vector<uint64_t> offsets;
+
+	/// <summary>Index of the target node of each edge</summary>
+	std::vector<uint32_t> targets;
+
+	/// <summary>Weight of each edge</summary>
+	std::vector<float> weights;
+
+	/// <summary>Position of each node label in the label pool</summary>
+	std::vector<uint64_t> nodeLabelOffsets;
+
+	/// <summary>Position of each edge label in the label pool</summary>
+	std::vector<uint64_t> edgeLabelOffsets;
+
+	/// <summary>Concatenation of all labels</summary>
+	std::string labelPool;
+
+	/// <summary>X-position and Y-position of each node</summary>
+	std::vector<float> coordinates;
+
+	/// <summary>If the position of each node is fixed</summary>
+	std::vector<uint8_t> fixed;
+
+	/// <summary>Original nodes</summary>
+	std::vector<Node*> nodes;
+
+	/// <summary>Original edges</summary>
+	std::vector<Edge*> edges;
+
+};
+
+#endif
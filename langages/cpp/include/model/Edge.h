@@ -39,11 +39,11 @@ public:
 	/// <summary>To string</summary>
 	/// <param name="nodeToIndex">Dictionary giving unique a unique index for each node</param>
 	/// <returns>DOT text</returns>
-	std::string ToDot(std::map<Node*, int> nodeToIndex);
+	std::string ToDot(const std::map<Node*, int>& nodeToIndex);
 
 	/// <summary>Name getter</summary>
 	/// <returns>Label of the edge</returns>
-	std::string GetName();
+	const std::string& GetName();
 
 	/// <summary>FromNode getter</summary>
 	/// <returns>Source of the edge</returns>
@@ -53,6 +53,14 @@ public:
 	/// <returns>Target of the edge</returns>
 	Node* GetToNode();
 
+	/// <summary>Weight getter</summary>
+	/// <returns>Cost of going through this edge for shortest paths (1 by default)</returns>
+	float GetWeight();
+
+	/// <summary>Weight setter</summary>
+	/// <param name="weight">Cost of going through this edge for shortest paths (must not be negative)</param>
+	void SetWeight(float weight);
+
 	/// <summary>IsValid getter</summary>
 	/// <returns>If this edge is valid (source and target nodes are not null)</returns>
 	bool IsValid();
@@ -68,6 +76,9 @@ private:
 	/// <summary>Target of the edge</summary>
 	Node* toNode;
 
+	/// <summary>Cost of going through this edge for shortest paths</summary>
+	float weight;
+
 	/// <summary>If this edge is valid (source and target nodes are not null)</summary>
 	bool isValid;
 
@@ -3,16 +3,36 @@
 
 #include "Node.h"
 #include "Edge.h"
+#include "CsrSnapshot.h"
+#include "GraphDelta.h"
+#include "SpatialIndex.h"
+#include "../io/DotPatchFile.h"
 
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <fstream>
 #include <stdlib.h>
 
 #include "../TinyXML/tinyxml.h"
 
+class DotWriter;
+class ForceLayout;
+class GraphView;
+class NodeOrder;
+class WorkerPool;
+
 /// <summary>Collections of nodes and edges</summary>
 class Graph{
 
+	// Views traverse the list of nodes without copying it
+	friend class GraphView;
+
 public:
 
 	/// <summary>Default constructor</summary>
@@ -91,48 +111,511 @@ public:
 	std::vector<Node*> GetNodes();
 
 
+	/// <summary>Set the number of threads formatting DOT text in ExportDot and drawing ExportPng images (the result is the same whatever the number of threads)</summary>
+	/// <param name="threadCount">Number of threads, 0 for one per core, 1 (default) for a sequential export</param>
+	void SetExportThreads(unsigned threadCount);
+
+	/// <summary>Set the number of threads parsing files in ImportEdgeList (the graph is the same whatever the number of threads)</summary>
+	/// <param name="threadCount">Number of threads, 0 (default) for one per core, 1 for a sequential import</param>
+	void SetImportThreads(unsigned threadCount);
+
+	/// <summary>Draw PNG and SVG images of ExportDot natively (see ExportPng and ExportSvg) instead of running Graphviz, when all nodes have a fixed position</summary>
+	/// <param name="enabled">True for native images, false (default) for Graphviz</param>
+	void SetNativeRendering(bool enabled);
+
+	/// <summary>Structural hash getter : it is updated from the nodes changed since the last call, not computed again from the whole graph</summary>
+	/// <returns>Hash of nodes, labels, positions and edges (the same graph built twice may have another hash, as nodes are identified by their creation order)</returns>
+	unsigned long long GetStructureHash();
+
+	/// <summary>Write compact DOT text in ExportDot : reciprocal edges with the same label become one edge with arrows on both sides, the most frequent direction and label of edges become default attributes, and node statements fit on one line</summary>
+	/// <param name="enabled">True for compact DOT text, false (default) for one statement per edge</param>
+	void SetCompactDot(bool enabled);
+
 	/// <summary>Convert C++ instances to DOT text (nodes will have free positions)</summary>
-	/// <param name="pathDot">The source node of the new edge</param>
-	void ExportDot(std::string pathDot);
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
+	/// <returns>If the DOT file and the images have been written (Graphviz errors are printed)</returns>
+	bool ExportDot(std::string pathDot);
 
 	/// <summary>Convert C++ instances to DOT text</summary>
-	/// <param name="pathDot">The source node of the new edge</param>
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
 	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
-	void ExportDot(std::string pathDot, float scale);
+	/// <returns>If the DOT file and the images have been written (Graphviz errors are printed)</returns>
+	bool ExportDot(std::string pathDot, float scale);
 
 	/// <summary>Convert C++ instances to DOT text (nodes will have free positions)</summary>
-	/// <param name="pathDot">The source node of the new edge</param>
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
 	/// <param name="pathPng">Path of PNG file to draw</param>
-	void ExportDot(std::string pathDot, std::string pathPng);
+	/// <returns>If the DOT file and the images have been written (Graphviz errors are printed)</returns>
+	bool ExportDot(std::string pathDot, std::string pathPng);
 
 	/// <summary>Convert C++ instances to DOT text (nodes will have free positions)</summary>
-	/// <param name="pathDot">The source node of the new edge</param>
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
 	/// <param name="pathPng">Path of PNG file to draw</param>
 	/// <param name="pathSvg">Path of SVG file to draw</param>
-	void ExportDot(std::string pathDot, std::string pathPng, std::string pathSvg);
+	/// <returns>If the DOT file and the images have been written (Graphviz errors are printed)</returns>
+	bool ExportDot(std::string pathDot, std::string pathPng, std::string pathSvg);
 
 	/// <summary>Convert C++ instances to DOT text</summary>
-	/// <param name="pathDot">The source node of the new edge</param>
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
 	/// <param name="pathPng">Path of PNG file to draw</param>
 	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
-	void ExportDot(std::string pathDot, std::string pathPng, float scale);
+	/// <returns>If the DOT file and the images have been written (Graphviz errors are printed)</returns>
+	bool ExportDot(std::string pathDot, std::string pathPng, float scale);
 
 	/// <summary>Convert C++ instances to DOT text</summary>
-	/// <param name="pathDot">The source node of the new edge</param>
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
 	/// <param name="pathPng">Path of PNG file to draw</param>
 	/// <param name="pathSvg">Path of SVG file to draw</param>
 	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
-	void ExportDot(std::string pathDot, std::string pathPng, std::string pathSvg, float scale);
+	/// <returns>If the DOT file and the images have been written (Graphviz errors are printed). Nothing is written if the graph and the parameters are the same as for the previous export, and if its files have not been modified since. Asynchronous exports writing the same files are waited for.</returns>
+	bool ExportDot(std::string pathDot, std::string pathPng, std::string pathSvg, float scale);
+
+	/// <summary>Convert the nodes and edges of a view to DOT text, without copying them (nodes will have free positions)</summary>
+	/// <param name="view">View of this graph to export</param>
+	/// <param name="pathDot">Path of DOT file to write</param>
+	/// <returns>If the DOT file has been written</returns>
+	bool ExportDot(GraphView& view, std::string pathDot);
+
+	/// <summary>Convert the nodes and edges of a view to DOT text, without copying them : nodes are identified by their position in GetNodes of the whole graph, so the files of several views of the same graph can be compared (the text is compact if SetCompactDot is on, reciprocal edges being paired inside the view)</summary>
+	/// <param name="view">View of this graph to export</param>
+	/// <param name="pathDot">Path of DOT file to write</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <returns>If the DOT file has been written (the file is always rewritten : views are not cached like ExportDot of the whole graph. Asynchronous exports writing the same file are waited for.)</returns>
+	bool ExportDot(GraphView& view, std::string pathDot, float scale);
+
+	/// <summary>Update a DOT file with the nodes changed since the last call (nodes will have free positions, see PatchDot with a scale)</summary>
+	/// <param name="pathDot">Path of DOT file to update</param>
+	/// <returns>If the DOT file has been written</returns>
+	bool PatchDot(std::string pathDot);
+
+	/// <summary>Update a DOT file with the nodes changed since the last call : only their blocks are rewritten in place, so the cost follows the size of the changes and not the size of the graph. The whole file is written by the first call, when the path or the scale changes, when the file has been modified by someone else, or when too much of it is blank. Unlike ExportDot, nodes are identified by a unique index which never changes (not by their position in GetNodes) and edge statements follow their source node.</summary>
+	/// <param name="pathDot">Path of DOT file to update</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <returns>If the DOT file has been written</returns>
+	bool PatchDot(std::string pathDot, float scale);
+
+	/// <summary>Convert C++ instances to DOT text in the background (nodes will have free positions, see ExportDotAsync with a scale)</summary>
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
+	/// <param name="pathPng">Path of PNG file to draw, empty if none</param>
+	/// <param name="pathSvg">Path of SVG file to draw, empty if none</param>
+	/// <returns>Future result of ExportDot</returns>
+	std::future<bool> ExportDotAsync(std::string pathDot, std::string pathPng, std::string pathSvg);
+
+	/// <summary>Convert C++ instances to DOT text in the background : a snapshot of the graph is taken now, then it is written and drawn by a worker thread (the graph can be modified meanwhile, the files are the same as the ones of ExportDot called now)</summary>
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
+	/// <param name="pathPng">Path of PNG file to draw, empty if none</param>
+	/// <param name="pathSvg">Path of SVG file to draw, empty if none</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <returns>Future result of ExportDot (already true if the files of the last ExportDot are up to date, already false if another export is writing one of the files)</returns>
+	std::future<bool> ExportDotAsync(std::string pathDot, std::string pathPng, std::string pathSvg, float scale);
+
+	/// <summary>Convert C++ instances to yEd-compatible GraphML text (free nodes are put on a grid, reciprocal edges with the same label become one edge with arrows on both sides)</summary>
+	/// <param name="path">Path of GraphML file to write</param>
+	void ExportGraphml(std::string path);
+
+	/// <summary>Draw nodes with a fixed position, their labels and their edges in a SVG file, without Graphviz (reciprocal edges with the same label become one edge with arrows on both sides)</summary>
+	/// <param name="path">Path of SVG file to write</param>
+	/// <returns>If the SVG file has been written (free nodes are not drawn, see ComputeLayout)</returns>
+	bool ExportSvg(std::string path);
+
+	/// <summary>Draw nodes with a fixed position and their edges in a PNG image, without Graphviz (the image is at most 4096 pixels wide and high)</summary>
+	/// <param name="path">Path of PNG file to write</param>
+	/// <returns>If the PNG file has been written (free nodes are not drawn, see ComputeLayout)</returns>
+	bool ExportPng(std::string path);
+
+	/// <summary>Draw nodes with a fixed position and their edges in a PNG image, without Graphviz (labels are not drawn)</summary>
+	/// <param name="path">Path of PNG file to write</param>
+	/// <param name="maxSize">Maximum width and height of the image in pixels : the drawing is reduced to fit</param>
+	/// <returns>If the PNG file has been written (free nodes are not drawn, see ComputeLayout)</returns>
+	bool ExportPng(std::string path, unsigned maxSize);
 
 	/// <summary>Read GraphML file to instanciate C++ objects</summary>
 	/// <param name="path">Path of GraphML file to read</param>
 	void ImportGraphml(std::string path);
 
+	/// <summary>Read GraphML file and merge it into existing C++ objects : nodes are matched by their GraphML unique index (from a previous import) or by their label, only changes are applied, and nodes from a previous import which are missing in this file are removed (see MergeGraphml with options)</summary>
+	/// <param name="path">Path of GraphML file to read</param>
+	/// <returns>Changes applied to the graph</returns>
+	GraphDelta MergeGraphml(std::string path);
+
+	/// <summary>Read GraphML file and merge it into existing C++ objects : only changes are applied. Nodes created by code are only renamed or moved when the file has their label : they never become imported nodes. Edges between two imported nodes follow the file, including edges created by code between them. Other edges created by code are kept.</summary>
+	/// <param name="path">Path of GraphML file to read</param>
+	/// <param name="matchByLabel">If nodes have to be matched only by their label (useful when yEd has renumbered unique indexes), else by their unique index from a previous import and then by their label</param>
+	/// <param name="removeMissing">If nodes from a previous import which are missing in this file have to be removed (nodes created by code are always kept)</param>
+	/// <returns>Changes applied to the graph</returns>
+	GraphDelta MergeGraphml(std::string path, bool matchByLabel, bool removeMissing);
+
+	/// <summary>Read an edge list file ("source,target,label" lines, see EdgeListFormat) to instanciate C++ objects</summary>
+	/// <param name="path">Path of edge list file to read</param>
+	void ImportEdgeList(std::string path);
+
+	/// <summary>Read an edge list file ("source,target,label" lines, see EdgeListFormat) to instanciate C++ objects</summary>
+	/// <param name="path">Path of edge list file to read</param>
+	/// <param name="separator">Character between fields (for example ',', ';' or '\t')</param>
+	void ImportEdgeList(std::string path, char separator);
+
+	/// <summary>Read a DOT file (written by ExportDot or by Graphviz, see DotFormat) to instanciate C++ objects (positions are read with scale 1)</summary>
+	/// <param name="path">Path of DOT file to read</param>
+	void ImportDot(std::string path);
+
+	/// <summary>Read a DOT file (written by ExportDot or by Graphviz, see DotFormat) to instanciate C++ objects</summary>
+	/// <param name="path">Path of DOT file to read</param>
+	/// <param name="scale">Divider-scale for positions (same value as the one given to ExportDot), 0 if free positions</param>
+	void ImportDot(std::string path, float scale);
+
+	/// <summary>Freeze nodes and edges in a compact snapshot (compressed sparse row layout)</summary>
+	/// <returns>Snapshot of the graph, node indices follow the order of GetNodes()</returns>
+	CsrSnapshot Freeze();
+
+	/// <summary>Instanciate C++ objects from a snapshot (see Freeze), in addition to existing ones</summary>
+	/// <param name="snapshot">Snapshot of nodes and edges</param>
+	void Thaw(const CsrSnapshot& snapshot);
+
+	/// <summary>Copy some nodes and the edges between them into another graph (induced subgraph)</summary>
+	/// <param name="selected">Nodes of this graph to copy (other nodes are ignored)</param>
+	/// <param name="subgraph">Graph receiving the copies, in addition to its existing nodes</param>
+	void ExtractSubgraph(const std::vector<Node*>& selected, Graph& subgraph);
+
+	/// <summary>Copy the nodes and edges of a view into another graph, through a snapshot (see GraphView::Freeze and Thaw)</summary>
+	/// <param name="view">View of this graph to copy</param>
+	/// <param name="subgraph">Graph receiving the copies, in addition to its existing nodes</param>
+	void ExtractSubgraph(GraphView& view, Graph& subgraph);
+
+	/// <summary>Compute the number of edges on a shortest path from a node to each node, following edge directions, on all cores (see BreadthFirstSearch)</summary>
+	/// <param name="source">First node</param>
+	/// <returns>Distance of each node in order of GetNodes(), BreadthFirstSearch::UNREACHED if there is no path</returns>
+	std::vector<uint32_t> ComputeDistances(Node* source);
+
+	/// <summary>Find a path of lowest total edge weight between two nodes, following edge directions (A* guided by positions when all nodes are fixed, see ShortestPath)</summary>
+	/// <param name="source">First node</param>
+	/// <param name="target">Last node</param>
+	/// <returns>Nodes of the path from the source to the target, empty if there is no path</returns>
+	std::vector<Node*> FindShortestPath(Node* source, Node* target);
+
+	/// <summary>Split the graph into components on all cores (see ConnectedComponents)</summary>
+	/// <param name="strong">If nodes of a component have to reach each other following edge directions, else edge directions are ignored</param>
+	/// <returns>Component of each node in order of GetNodes(), from 0 to the number of components minus 1</returns>
+	std::vector<uint32_t> ComputeComponents(bool strong);
+
+	/// <summary>Sort nodes so that each node comes after all the sources of its incoming edges (see TopologicalOrder)</summary>
+	/// <returns>Nodes in topological order, empty if the graph has a cycle (the cycle is printed)</returns>
+	std::vector<Node*> SortTopologically();
+
+	/// <summary>Find the path of greatest total edge weight, edge weights being delays, on all cores (see TimingAnalysis for arrival and required times)</summary>
+	/// <returns>Nodes of the critical path, empty if the graph has a cycle (the cycle is printed)</returns>
+	std::vector<Node*> FindCriticalPath();
+
+	/// <summary>Rank nodes by importance with PageRank on all cores (see PageRank for its settings)</summary>
+	/// <returns>Rank of each node in order of GetNodes(), their sum is 1</returns>
+	std::vector<double> ComputePageRank();
+
+	/// <summary>Compute the betweenness centrality of the nodes on all cores (see Betweenness)</summary>
+	/// <param name="samples">Number of sources picked at random to estimate it, 0 for the exact centrality (slower)</param>
+	/// <returns>Centrality of each node in order of GetNodes()</returns>
+	std::vector<double> ComputeBetweenness(size_t samples);
+
+	/// <summary>Find the fixed nodes inside a box (see SpatialIndex, built by the first search and then kept up to date)</summary>
+	/// <param name="minX">Left of the box</param>
+	/// <param name="minY">Top of the box</param>
+	/// <param name="maxX">Right of the box</param>
+	/// <param name="maxY">Bottom of the box</param>
+	/// <returns>Nodes inside the box, in no particular order</returns>
+	std::vector<Node*> FindNodesInBox(float minX, float minY, float maxX, float maxY);
+
+	/// <summary>Find the fixed nodes inside a circle</summary>
+	/// <param name="x">X-position of the center</param>
+	/// <param name="y">Y-position of the center</param>
+	/// <param name="radius">Radius of the circle</param>
+	/// <returns>Nodes inside the circle, in no particular order</returns>
+	std::vector<Node*> FindNodesInRadius(float x, float y, float radius);
+
+	/// <summary>Find the fixed nodes nearest to a point</summary>
+	/// <param name="x">X-position of the point</param>
+	/// <param name="y">Y-position of the point</param>
+	/// <param name="count">Number of nodes to find</param>
+	/// <returns>The nearest nodes, the nearest first</returns>
+	std::vector<Node*> FindNearestNodes(float x, float y, size_t count);
+
+	/// <summary>Find the node under a point, for instance under a click</summary>
+	/// <param name="x">X-position of the point</param>
+	/// <param name="y">Y-position of the point</param>
+	/// <param name="radius">Greatest distance between the point and the position of the node</param>
+	/// <returns>Nearest fixed node in the radius, NULL if none</returns>
+	Node* FindNodeAt(float x, float y, float radius);
+
+	/// <summary>Place free nodes with a force-directed layout on all cores (see ForceLayout) : they become fixed, so ExportDot keeps their position</summary>
+	void ComputeLayout();
+
+	/// <summary>Place free nodes with a force-directed layout : they become fixed, so ExportDot keeps their position</summary>
+	/// <param name="layout">Layout engine with its settings</param>
+	void ComputeLayout(ForceLayout& layout);
+
+	/// <summary>Renumber nodes with reverse Cuthill-McKee (see NodeOrder), so neighbours get close dense indexes and algorithms run faster on snapshots</summary>
+	void Reorder();
+
+	/// <summary>Renumber nodes : the order of GetNodes() changes, so do the snapshots and the files of ExportDot, but nodes and edges stay the same objects</summary>
+	/// <param name="order">Ordering engine with its settings</param>
+	void Reorder(NodeOrder& order);
+
+	/// <summary>Write the graph in the native binary format (see BinaryFormat)</summary>
+	/// <param name="path">Path of binary file to write</param>
+	/// <returns>If the file has been entirely written</returns>
+	bool SaveBinary(std::string path);
+
+	/// <summary>Read a file in the native binary format (see BinaryFormat) to instanciate C++ objects</summary>
+	/// <param name="path">Path of binary file to read</param>
+	/// <returns>If the file is valid (if not, nothing has been added to the graph)</returns>
+	bool LoadBinary(std::string path);
+
 private:
 
+	/// <summary>Node read from a GraphML file</summary>
+	struct GraphmlNode{
+		std::string id;
+		std::string name;
+		float x;
+		float y;
+	};
+
+	/// <summary>Edge read from a GraphML file (already oriented from source to target)</summary>
+	struct GraphmlEdge{
+		std::string source;
+		std::string target;
+		std::string name;
+		bool isBidirectional;
+	};
+
+	/// <summary>Choices of a compact DOT export (see SetCompactDot)</summary>
+	struct DotCompaction{
+		std::vector<bool> pairedEdges;		// If each edge has a reverse edge (see FindReverseEdges)
+		std::vector<size_t> firstEdges;		// Number of the first outgoing edge of each node
+		bool bidirectionalByDefault;		// If edges have arrows on both sides by default
+		std::string label;			// Default label of edges
+	};
+
+	/// <summary>File written by an export, to check that it has not been modified since</summary>
+	struct ExportedFile{
+		std::string path;
+		long long size;
+		long long modifiedSec;
+		long long modifiedNsec;
+		bool operator==(const ExportedFile& other) const;
+	};
+
+	/// <summary>Files written by an asynchronous export, with the hash of the graph when it has been started</summary>
+	struct AsyncExportRecord{
+		std::mutex lock;
+		unsigned long long ticket;		// Number of the export, 0 if none has succeeded
+		unsigned long long hash;
+		std::vector<ExportedFile> files;
+	};
+
+	/// <summary>Number of nodes and edges formatted in one block of a parallel export, written as soon as it is ready</summary>
+	static const size_t EXPORT_BLOCK_SIZE = 1 << 14;
+
 	/// <summary>List of nodes</summary>
 	std::vector<Node*> nodes;
 
+	/// <summary>Unique index given to the next created node</summary>
+	long long nextSerial;
+
+	/// <summary>Nodes changed since the structural hash has been updated : created, renamed, moved, or whose outgoing edges changed</summary>
+	std::vector<Node*> changedNodes;
+
+	/// <summary>Sum of the hashes of the nodes which have been hashed</summary>
+	unsigned long long structureHash;
+
+	/// <summary>Nodes changed since the last PatchDot</summary>
+	std::unordered_set<Node*> unpatchedNodes;
+
+	/// <summary>Unique indexes of nodes deleted since the last PatchDot</summary>
+	std::vector<long long> deletedSerials;
+
+	/// <summary>DOT file updated by PatchDot</summary>
+	DotPatchFile dotPatch;
+
+	/// <summary>Fixed nodes by position, updated with changed nodes once it has been built</summary>
+	SpatialIndex spatialIndex;
+
+	/// <summary>Hash of the graph and of the parameters of the last ExportDot (0 if none)</summary>
+	unsigned long long exportHash;
+
+	/// <summary>Files written by the last ExportDot, with their size and their modification time</summary>
+	std::vector<ExportedFile> exportedFiles;
+
+	/// <summary>Number of exports started, to number each of them</summary>
+	unsigned long long exportTicket;
+
+	/// <summary>Number of the export described by exportHash and exportedFiles (a pending asynchronous export replaces them only if it is more recent)</summary>
+	unsigned long long recordedTicket;
+
+	/// <summary>Last asynchronous export which succeeded, filled by the worker thread and collected by the graph</summary>
+	std::shared_ptr<AsyncExportRecord> asyncExport;
+
+	/// <summary>Number of threads formatting DOT text and drawing images, 0 for one per core</summary>
+	unsigned exportThreads;
+
+	/// <summary>Number of threads parsing imported files, 0 for one per core</summary>
+	unsigned importThreads;
+
+	/// <summary>If images of positioned graphs are drawn without Graphviz</summary>
+	bool nativeRendering;
+
+	/// <summary>If ExportDot writes compact DOT text</summary>
+	bool compactDot;
+
+	/// <summary>Nodes imported from GraphML files, key is unique index from GraphML</summary>
+	std::unordered_map<std::string, Node*> graphmlIdToNode;
+
+	/// <summary>Unique index from GraphML of imported nodes</summary>
+	std::unordered_map<Node*, std::string> nodeToGraphmlId;
+
+	/// <summary>Copy is forbidden : nodes would be destroyed twice</summary>
+	Graph(const Graph&);
+
+	/// <summary>Copy is forbidden : nodes would be destroyed twice</summary>
+	Graph& operator=(const Graph&);
+
+	/// <summary>Threads running asynchronous exports of all graphs</summary>
+	/// <returns>Shared pool, created at first use</returns>
+	static WorkerPool& GetExportPool();
+
+	/// <summary>Threads formatting the text of parallel exports of all graphs, one per core</summary>
+	/// <returns>Shared pool, created at first use</returns>
+	static WorkerPool& GetFormatPool();
+
+	/// <summary>Hash the graph with the parameters of an export</summary>
+	/// <param name="paths">Paths of the files to write</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <returns>Hash to compare with the one of the last export</returns>
+	unsigned long long HashExport(const std::vector<std::string>& paths, float scale);
+
+	/// <summary>Take the result of the last asynchronous export which succeeded, if it is more recent than the last recorded export</summary>
+	void CollectAsyncExport();
+
+	/// <summary>Check if the files of the last export are up to date</summary>
+	/// <param name="hash">Hash of the graph and of the parameters of the new export (see HashExport)</param>
+	/// <param name="paths">Paths of the files to write</param>
+	/// <returns>If the last export had the same hash and if its files have not been modified since</returns>
+	bool IsExportUpToDate(unsigned long long hash, const std::vector<std::string>& paths);
+
+	/// <summary>Update the structural hash and the spatial index with the log of changed nodes, and empty this log</summary>
+	void ApplyChanges();
+
+	/// <summary>Build the spatial index if it has not been built yet, and update it with changed nodes</summary>
+	void PrepareSpatialIndex();
+
+	/// <summary>Hash a node with its label, its position and its outgoing edges</summary>
+	/// <param name="node">Node to hash</param>
+	/// <returns>Hash of the node (never 0)</returns>
+	unsigned long long HashNode(Node* node);
+
+	/// <summary>Mix a value into a hash</summary>
+	/// <param name="hash">Hash to update</param>
+	/// <param name="value">Value to add</param>
+	/// <returns>New hash</returns>
+	static unsigned long long MixHash(unsigned long long hash, unsigned long long value);
+
+	/// <summary>Find the size and the modification time of written files</summary>
+	/// <param name="paths">Paths of the written files (empty paths are ignored)</param>
+	/// <param name="files">Found files</param>
+	/// <returns>If all files exist</returns>
+	static bool FindExportedFiles(const std::vector<std::string>& paths, std::vector<ExportedFile>& files);
+
+	/// <summary>Convert C++ instances to DOT text and draw images, even if they are up to date (see ExportDot)</summary>
+	/// <param name="pathDot">Path of DOT file to write, empty to stream DOT text to Graphviz without writing a file</param>
+	/// <param name="pathPng">Path of PNG file to draw</param>
+	/// <param name="pathSvg">Path of SVG file to draw</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <returns>If the DOT file and the images have been written (Graphviz errors are printed)</returns>
+	bool WriteDotExport(std::string pathDot, std::string pathPng, std::string pathSvg, float scale);
+
+	/// <summary>Give a new node its indexes and register it in the list of nodes</summary>
+	/// <param name="newNode">Created node</param>
+	/// <returns>Created node</returns>
+	Node* AddNode(Node* newNode);
+
+	/// <summary>Write all node statements or all edge statements, formatted by several threads if asked : each thread formats a contiguous range of nodes with the same number of statements, block by block, and ready blocks are written in order while the next ones are formatted</summary>
+	/// <param name="fichier">DOT file to write</param>
+	/// <param name="edges">If edges have to be written, else nodes</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <param name="compaction">Choices of a compact export, null for one statement per edge</param>
+	/// <param name="ignoredEdges">Incremented by the number of edges going to a node which is not in this graph</param>
+	void WriteDotSection(DotWriter& fichier, bool edges, float scale, const DotCompaction* compaction, size_t& ignoredEdges);
+
+	/// <summary>Write node statements or edge statements for a range of nodes</summary>
+	/// <param name="out">Where to write</param>
+	/// <param name="first">Index of the first node</param>
+	/// <param name="last">Index after the last node</param>
+	/// <param name="edges">If outgoing edges have to be written, else nodes</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <param name="compaction">Choices of a compact export, null for one statement per edge</param>
+	/// <returns>Number of edges going to a node which is not in this graph</returns>
+	size_t WriteDotRange(DotWriter& out, size_t first, size_t last, bool edges, float scale, const DotCompaction* compaction);
+
+	/// <summary>Choose the default attributes of a compact DOT export</summary>
+	/// <param name="compaction">Choices to fill</param>
+	void PrepareCompaction(DotCompaction& compaction);
+
+	/// <summary>Choose the most frequent direction and label of the written edges as defaults of a compact DOT export</summary>
+	/// <param name="edges">Edges to write</param>
+	/// <param name="compaction">Choices with the pairs of the edges (see FindReverseEdges), defaults are filled</param>
+	void ChooseEdgeDefaults(const std::vector<Edge*>& edges, DotCompaction& compaction);
+
+	/// <summary>Write the DOT file of a view (see ExportDot with a view), once the file is reserved</summary>
+	/// <param name="view">View of this graph to export</param>
+	/// <param name="pathDot">Path of DOT file to write</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <returns>If the DOT file has been written</returns>
+	bool WriteDotView(GraphView& view, std::string pathDot, float scale);
+
+	/// <summary>Write the block of a node patched by PatchDot : its node statement, then its outgoing edge statements, with unique indexes of nodes</summary>
+	/// <param name="out">Where to write</param>
+	/// <param name="node">Node to write</param>
+	/// <param name="scale">Multiplier-scale for positions, 0 if free positions</param>
+	/// <returns>Number of edges going to a node which is not in this graph</returns>
+	size_t WriteDotBlock(DotWriter& out, Node* node, float scale);
+
+	/// <summary>Compute the bounds of nodes with a fixed position (a warning is printed if some nodes are free)</summary>
+	/// <param name="minX">Lowest X-position, 0 if no node is drawn</param>
+	/// <param name="minY">Lowest Y-position, 0 if no node is drawn</param>
+	/// <param name="maxX">Highest X-position, 0 if no node is drawn</param>
+	/// <param name="maxY">Highest Y-position, 0 if no node is drawn</param>
+	/// <returns>Number of nodes with a fixed position</returns>
+	size_t FindDrawingBounds(float& minX, float& minY, float& maxX, float& maxY);
+
+	/// <summary>Call a function for each edge to draw : between nodes with a fixed position, once for a pair of reverse edges</summary>
+	/// <param name="pairedEdges">If each edge has a reverse edge (see FindReverseEdges)</param>
+	/// <param name="ignoredEdges">Incremented for each edge going to a node which is not in this graph</param>
+	/// <param name="visit">Function called with the source node, the target node, the edge and if it is drawn with arrows on both sides</param>
+	void VisitDrawnEdges(const std::vector<bool>& pairedEdges, size_t& ignoredEdges, const std::function<void(Node*, Node*, Edge*, bool)>& visit);
+
+	/// <summary>Pair each edge with an edge in the opposite direction with the same label (each edge is used in one pair at most, loops are never paired)</summary>
+	/// <returns>If each edge is paired, edges being numbered in order of nodes then of their outgoing edges</returns>
+	std::vector<bool> FindReverseEdges();
+
+	/// <summary>Pair each edge of a list with an edge of the list in the opposite direction with the same label (each edge is used in one pair at most, loops are never paired)</summary>
+	/// <param name="edges">Edges to pair</param>
+	/// <returns>If each edge of the list is paired</returns>
+	std::vector<bool> FindReverseEdges(const std::vector<Edge*>& edges);
+
+	/// <summary>Check if a node is in the list of nodes (in constant time, thanks to its dense index)</summary>
+	/// <param name="node">Node to check</param>
+	/// <returns>If the node belongs to this graph</returns>
+	bool Contains(Node* node);
+
+	/// <summary>Read nodes and edges from a GraphML file without modifying the graph</summary>
+	/// <param name="path">Path of GraphML file to read</param>
+	/// <param name="xmlNodesRead">Read nodes</param>
+	/// <param name="xmlEdgesRead">Read edges, between read nodes only</param>
+	/// <returns>If the file has been read</returns>
+	bool ReadGraphml(std::string path, std::vector<GraphmlNode>& xmlNodesRead, std::vector<GraphmlEdge>& xmlEdgesRead);
+
+	/// <summary>Remember the unique index from GraphML of a node</summary>
+	/// <param name="node">Imported node</param>
+	/// <param name="id">Unique index from GraphML</param>
+	void IndexGraphmlId(Node* node, std::string id);
+
 	/// <summary>Find a child with given tag from an XML element</summary>
 	/// <param name="xmlSuper">XML element to analyse</param>
 	/// <param name="childTag">Child tag to find</param>
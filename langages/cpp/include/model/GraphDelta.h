@@ -0,0 +1,45 @@
+#ifndef GRAPH_DELTA_H
+#define GRAPH_DELTA_H
+
+#include "Node.h"
+
+#include <string>
+#include <vector>
+
+/// <summary>Changes applied to a graph by a merge</summary>
+class GraphDelta{
+
+public:
+
+	/// <summary>Default constructor (no change)</summary>
+	GraphDelta();
+
+	/// <summary>If nothing has changed</summary>
+	/// <returns>If the delta is empty</returns>
+	bool IsEmpty();
+
+	/// <summary>To string</summary>
+	/// <returns>Text</returns>
+	std::string ToString();
+
+	/// <summary>Created nodes</summary>
+	std::vector<Node*> addedNodes;
+
+	/// <summary>Nodes with a new label</summary>
+	std::vector<Node*> renamedNodes;
+
+	/// <summary>Nodes with a new position</summary>
+	std::vector<Node*> movedNodes;
+
+	/// <summary>Labels of deleted nodes</summary>
+	std::vector<std::string> removedNodes;
+
+	/// <summary>Number of created edges</summary>
+	size_t addedEdges;
+
+	/// <summary>Number of deleted edges</summary>
+	size_t removedEdges;
+
+};
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef GRAPH_VIEW_H
+#define GRAPH_VIEW_H
+
+#include "Graph.h"
+
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>Part of a graph seen without copying it : nodes and edges are filtered each time the view is traversed, so it follows the changes of the graph. Filters add up : a node is in the view if it passes all node filters, an edge if it passes all edge filters and its two nodes are in the view</summary>
+class GraphView{
+
+public:
+
+	/// <summary>Constructor (all nodes and edges of the graph until filters are added)</summary>
+	/// <param name="graph">Graph seen by the view, which must outlive it</param>
+	explicit GraphView(Graph& graph);
+
+	/// <summary>Keep only the nodes accepted by a function</summary>
+	/// <param name="keepNode">Function returning if a node is in the view</param>
+	void FilterNodes(std::function<bool(Node*)> keepNode);
+
+	/// <summary>Keep only the edges accepted by a function</summary>
+	/// <param name="keepEdge">Function returning if an edge is in the view</param>
+	void FilterEdges(std::function<bool(Edge*)> keepEdge);
+
+	/// <summary>Keep only the nodes of a component : components are computed now (see Graph::ComputeComponents), nodes created later are not in the view</summary>
+	/// <param name="component">Component, as given by Graph::ComputeComponents</param>
+	/// <param name="strong">If components are strongly connected, else edge directions are ignored</param>
+	void FilterComponent(uint32_t component, bool strong);
+
+	/// <summary>Keep only the fixed nodes inside a box (found with the spatial index of the graph, see Graph::FindNodesInBox)</summary>
+	/// <param name="minX">Left of the box</param>
+	/// <param name="minY">Top of the box</param>
+	/// <param name="maxX">Right of the box</param>
+	/// <param name="maxY">Bottom of the box</param>
+	void FilterBox(float minX, float minY, float maxX, float maxY);
+
+	/// <summary>Check if a node is in the view</summary>
+	/// <param name="node">Node to check</param>
+	/// <returns>If the node is in the graph and passes all node filters</returns>
+	bool ContainsNode(Node* node);
+
+	/// <summary>Check if an edge is in the view</summary>
+	/// <param name="edge">Edge to check</param>
+	/// <returns>If the edge passes all edge filters and its two nodes are in the view</returns>
+	bool ContainsEdge(Edge* edge);
+
+	/// <summary>Call a function on each node of the view, in order of Graph::GetNodes() (do not add or delete nodes meanwhile)</summary>
+	/// <param name="visit">Function called with each node</param>
+	void VisitNodes(const std::function<void(Node*)>& visit);
+
+	/// <summary>Call a function on each outgoing edge of a node which is in the view</summary>
+	/// <param name="node">Source node</param>
+	/// <param name="visit">Function called with each edge</param>
+	void VisitEdges(Node* node, const std::function<void(Edge*)>& visit);
+
+	/// <summary>Nodes getter</summary>
+	/// <returns>Nodes of the view, in order of Graph::GetNodes()</returns>
+	std::vector<Node*> GetNodes();
+
+	/// <summary>Edges getter</summary>
+	/// <param name="node">Source node</param>
+	/// <returns>Outgoing edges of the node which are in the view</returns>
+	std::vector<Edge*> GetEdges(Node* node);
+
+	/// <summary>Graph getter</summary>
+	/// <returns>Graph seen by the view</returns>
+	Graph& GetGraph();
+
+	/// <summary>Freeze nodes and edges of the view in a compact snapshot, so algorithms can run on the view (see Graph::Freeze)</summary>
+	/// <returns>Snapshot of the view, node indices follow the order of GetNodes()</returns>
+	CsrSnapshot Freeze();
+
+private:
+
+	/// <summary>Check an edge against the edge filters only</summary>
+	/// <param name="edge">Edge to check</param>
+	/// <returns>If the edge passes all edge filters</returns>
+	bool PassesEdgeFilters(Edge* edge);
+
+	/// <summary>Graph seen by the view</summary>
+	Graph& graph;
+
+	/// <summary>Functions all nodes of the view pass</summary>
+	std::vector<std::function<bool(Node*)> > nodeFilters;
+
+	/// <summary>Functions all edges of the view pass</summary>
+	std::vector<std::function<bool(Edge*)> > edgeFilters;
+
+	/// <summary>If nodes are limited to a box</summary>
+	bool hasBox;
+
+	/// <summary>Left of the box</summary>
+	float minX;
+
+	/// <summary>Top of the box</summary>
+	float minY;
+
+	/// <summary>Right of the box</summary>
+	float maxX;
+
+	/// <summary>Bottom of the box</summary>
+	float maxY;
+
+};
+
+#endif
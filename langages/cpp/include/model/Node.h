@@ -12,6 +12,9 @@ class Edge;
 /// <summary>Node of the graph</summary>
 class Node{
 
+	// The Graph-object maintains the dense index of its nodes and the log of changed nodes
+	friend class Graph;
+
 public:
 
 	/// <summary>Default constructor (unnamed and free node)</summary>
@@ -85,7 +88,7 @@ public:
 
 	/// <summary>Name getter</summary>
 	/// <returns>Label of the node</returns>
-	std::string GetName();
+	const std::string& GetName();
 
 	/// <summary>X getter</summary>
 	/// <returns>X-position</returns>
@@ -96,13 +99,26 @@ public:
 	float GetY();
 
 	/// <summary>Edges getter</summary>
-	/// <returns>List of edges outgoing from this node. If Graph-object is used, do not try to modify theses edges manually ! (use Graph-object's functions)</returns>
-	std::vector<Edge*> GetEdges();
+	/// <returns>List of edges outgoing from this node (not a copy : copy it before deleting edges while iterating). If Graph-object is used, do not try to modify theses edges manually ! (use Graph-object's functions)</returns>
+	const std::vector<Edge*>& GetEdges();
+
+	/// <summary>Index getter</summary>
+	/// <returns>Position of this node in the list of nodes of its Graph-object (-1 if it has not been created by a Graph-object)</returns>
+	int GetIndex();
 
 	/// <summary>IsFixedPos getter</summary>
 	/// <returns>If X-Y-position is fixed</returns>
 	bool IsFixedPos();
 
+	/// <summary>Name setter</summary>
+	/// <param name="name">New label of the node</param>
+	void SetName(std::string name);
+
+	/// <summary>Position setter : the node becomes fixed</summary>
+	/// <param name="x">X-position</param>
+	/// <param name="y">Y-position</param>
+	void SetPos(float x, float y);
+
 private:
 
 	/// <summary>Remove an edge from the list of incoming edges to this node. This edge will not be destroyed here ; it should be destroyed by the other node from where this edge come from.</summary>
@@ -114,6 +130,9 @@ private:
 	/// <param name="unregisterReverseIncomingEdge">If reverse edges going from this node to the actual node have to be unregistered from list of incoming edges of the actual node</param>
 	void DeleteEdgesToNode(Node* notNeighbourAnymore, bool unregisterReverseIncomingEdge);
 
+	/// <summary>Register this node in the log of changed nodes of its Graph-object (once until the log is cleared)</summary>
+	void Touch();
+
 	/// <summary>Label of the node</summary>
 	std::string name;
 
@@ -126,6 +145,21 @@ private:
 	/// <summary>If X-Y-position is fixed</summary>
 	bool fixedPos;
 
+	/// <summary>Position of this node in the list of nodes of its Graph-object (-1 if none)</summary>
+	int index;
+
+	/// <summary>Unique index of this node in its Graph-object, which never changes (-1 if none)</summary>
+	long long serial;
+
+	/// <summary>Log of changed nodes of its Graph-object (null if none)</summary>
+	std::vector<Node*>* changeLog;
+
+	/// <summary>If this node is in the log of changed nodes</summary>
+	bool changed;
+
+	/// <summary>Contribution of this node to the structural hash of its Graph-object (0 until it has been hashed)</summary>
+	unsigned long long hash;
+
 	/// <summary>List of edges outgoing from this node</summary>
 	std::vector<Edge*> edges;
 
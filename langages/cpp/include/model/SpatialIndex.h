@@ -0,0 +1,129 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "Node.h"
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>Index of fixed nodes by position : a uniform grid of square cells, stored in a hash map so empty cells cost nothing. The size of the cells follows the density of the nodes (a few nodes per cell) and is chosen again when the number of nodes or their spread has changed too much</summary>
+class SpatialIndex{
+
+public:
+
+	/// <summary>Default constructor (empty index, not built)</summary>
+	SpatialIndex();
+
+	/// <summary>Index a list of nodes (free nodes are ignored), replacing the indexed ones</summary>
+	/// <param name="nodes">Nodes to index</param>
+	void Build(const std::vector<Node*>& nodes);
+
+	/// <summary>Take a created, moved or changed node into account : it is indexed at its position if it is fixed, else removed</summary>
+	/// <param name="node">Node to update</param>
+	void Update(Node* node);
+
+	/// <summary>Remove a node from the index</summary>
+	/// <param name="node">Node to remove (ignored if it is not indexed)</param>
+	void Remove(Node* node);
+
+	/// <summary>Remove all nodes : the index is not built anymore</summary>
+	void Clear();
+
+	/// <summary>Check if the index has been built</summary>
+	/// <returns>If nodes are indexed and have to be updated</returns>
+	bool IsBuilt();
+
+	/// <summary>Size getter</summary>
+	/// <returns>Number of indexed nodes</returns>
+	size_t GetSize();
+
+	/// <summary>Find the nodes inside a box (borders included)</summary>
+	/// <param name="minX">Left of the box</param>
+	/// <param name="minY">Top of the box</param>
+	/// <param name="maxX">Right of the box</param>
+	/// <param name="maxY">Bottom of the box</param>
+	/// <returns>Nodes inside the box, in no particular order</returns>
+	std::vector<Node*> FindInBox(float minX, float minY, float maxX, float maxY);
+
+	/// <summary>Find the nodes inside a circle (border included)</summary>
+	/// <param name="x">X-position of the center</param>
+	/// <param name="y">Y-position of the center</param>
+	/// <param name="radius">Radius of the circle</param>
+	/// <returns>Nodes inside the circle, in no particular order</returns>
+	std::vector<Node*> FindInRadius(float x, float y, float radius);
+
+	/// <summary>Find the nodes nearest to a point, searching rings of cells around it until no closer node can remain</summary>
+	/// <param name="x">X-position of the point</param>
+	/// <param name="y">Y-position of the point</param>
+	/// <param name="count">Number of nodes to find</param>
+	/// <returns>The count nodes nearest to the point (fewer if less nodes are indexed), the nearest first</returns>
+	std::vector<Node*> FindNearest(float x, float y, size_t count);
+
+private:
+
+	/// <summary>Indexed node with a copy of its position</summary>
+	struct Entry{
+		Node* node;
+		float x;
+		float y;
+	};
+
+	/// <summary>Compute the cell coordinate of a position</summary>
+	/// <param name="value">X-position or Y-position</param>
+	/// <returns>Index of the column or row of the cell</returns>
+	int32_t ToCell(float value);
+
+	/// <summary>Compute the key of a cell in the map</summary>
+	/// <param name="column">Column of the cell</param>
+	/// <param name="row">Row of the cell</param>
+	/// <returns>Key of the cell</returns>
+	static uint64_t CellKey(int32_t column, int32_t row);
+
+	/// <summary>Add an entry to its cell</summary>
+	/// <param name="entry">Node and its position</param>
+	void Insert(const Entry& entry);
+
+	/// <summary>Choose a cell size for some entries and put them in new cells</summary>
+	/// <param name="entries">Nodes and their positions</param>
+	void Rebuild(const std::vector<Entry>& entries);
+
+	/// <summary>Build the grid again if it does not fit the indexed nodes anymore (too many or too few nodes, crowded cell)</summary>
+	void RebuildIfNeeded();
+
+	/// <summary>Side of the cells</summary>
+	float cellSize;
+
+	/// <summary>Entries of each non-empty cell, key is given by CellKey</summary>
+	std::unordered_map<uint64_t, std::vector<Entry> > cells;
+
+	/// <summary>Key of the cell of each indexed node</summary>
+	std::unordered_map<Node*, uint64_t> nodeCells;
+
+	/// <summary>If the index has been built</summary>
+	bool built;
+
+	/// <summary>Number of nodes when the cell size has been chosen</summary>
+	size_t builtCount;
+
+	/// <summary>Number of entries of a cell above which the grid is built again</summary>
+	size_t crowdLimit;
+
+	/// <summary>If a cell has more than crowdLimit entries</summary>
+	bool crowded;
+
+	/// <summary>Lowest column of the cells used since the grid has been built</summary>
+	int32_t minColumn;
+
+	/// <summary>Highest column of the cells used since the grid has been built</summary>
+	int32_t maxColumn;
+
+	/// <summary>Lowest row of the cells used since the grid has been built</summary>
+	int32_t minRow;
+
+	/// <summary>Highest row of the cells used since the grid has been built</summary>
+	int32_t maxRow;
+
+};
+
+#endif
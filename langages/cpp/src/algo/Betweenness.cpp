@@ -0,0 +1,126 @@
+#include "../../include/algo/Betweenness.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+Betweenness::Betweenness(){
+	samples = 0;
+	seed = 0;
+	threadCount = 1;
+}
+
+void Betweenness::SetSamples(size_t samples){
+	this->samples = samples;
+}
+
+void Betweenness::SetSeed(unsigned seed){
+	this->seed = seed;
+}
+
+void Betweenness::SetThreads(unsigned threadCount){
+	this->threadCount = threadCount;
+}
+
+void Betweenness::Run(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	vector<uint32_t> sources(n);			// Nodes whose paths are counted
+	for(size_t i = 0; i < n; i++){
+		sources[i] = i;
+	}
+	// Sampled sources are the first ones of a partial shuffle
+	if(samples > 0 && samples < n){
+		mt19937 generator(seed);
+		for(size_t i = 0; i < samples; i++){
+			swap(sources[i], sources[i + generator() % (n - i)]);
+		}
+		sources.resize(samples);
+	}
+	unsigned threads = threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+	threads = (unsigned) max((size_t) 1, min((size_t) threads, sources.size()));
+	vector<Workspace> workspaces(threads);
+	for(vector<Workspace>::iterator workspace = workspaces.begin(); workspace != workspaces.end(); ++workspace){
+		workspace->distances.assign(n, -1);
+		workspace->pathCounts.assign(n, 0);
+		workspace->dependencies.assign(n, 0);
+		workspace->scores.assign(n, 0);
+	}
+	if(threads == 1){
+		for(size_t i = 0; i < sources.size(); i++){
+			AddSource(snapshot, sources[i], workspaces[0]);
+		}
+	}
+	else{
+		// Each thread takes every threads-th source, with its own arrays
+		vector<thread> workers;
+		for(unsigned t = 0; t < threads; t++){
+			workers.push_back(thread([&snapshot, &sources, &workspaces, t, threads](){
+				for(size_t i = t; i < sources.size(); i += threads){
+					AddSource(snapshot, sources[i], workspaces[t]);
+				}
+			}));
+		}
+		for(vector<thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker){
+			worker->join();
+		}
+	}
+	double scale = sources.empty() ? 0 : (double) n / sources.size();	// Sampled sources stand for all nodes
+	scores.assign(n, 0);
+	for(size_t i = 0; i < n; i++){
+		for(unsigned t = 0; t < threads; t++){
+			scores[i] += workspaces[t].scores[i];
+		}
+		scores[i] *= scale;
+	}
+}
+
+const vector<double>& Betweenness::GetScores(){return scores;}
+
+void Betweenness::AddSource(const CsrSnapshot& snapshot, uint32_t source, Workspace& workspace){
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	vector<int32_t>& distances = workspace.distances;
+	vector<double>& pathCounts = workspace.pathCounts;
+	vector<double>& dependencies = workspace.dependencies;
+	vector<uint32_t>& order = workspace.order;
+	// Breadth-first search counting shortest paths : the order of reached nodes is the queue
+	order.clear();
+	order.push_back(source);
+	distances[source] = 0;
+	pathCounts[source] = 1;
+	for(size_t head = 0; head < order.size(); head++){
+		uint32_t node = order[head];
+		for(uint64_t e = offsets[node]; e < offsets[node + 1]; e++){
+			uint32_t next = targets[e];
+			if(distances[next] < 0){
+				distances[next] = distances[node] + 1;
+				order.push_back(next);
+			}
+			if(distances[next] == distances[node] + 1){
+				pathCounts[next] += pathCounts[node];
+			}
+		}
+	}
+	// Shares are gathered from the successors on shortest paths, farthest nodes first, so no list of predecessors is needed
+	for(size_t i = order.size(); i > 0; i--){
+		uint32_t node = order[i - 1];
+		double dependency = 0;
+		for(uint64_t e = offsets[node]; e < offsets[node + 1]; e++){
+			uint32_t next = targets[e];
+			if(distances[next] == distances[node] + 1){
+				dependency += pathCounts[node] / pathCounts[next] * (1 + dependencies[next]);
+			}
+		}
+		dependencies[node] = dependency;
+		if(node != source){
+			workspace.scores[node] += dependency;
+		}
+	}
+	for(vector<uint32_t>::iterator node = order.begin(); node != order.end(); ++node){
+		distances[*node] = -1;
+		pathCounts[*node] = 0;
+		dependencies[*node] = 0;
+	}
+}
@@ -0,0 +1,226 @@
+#include "../../include/algo/BreadthFirstSearch.h"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+const uint32_t BreadthFirstSearch::UNREACHED;
+
+// Edges to check below which a step is not worth threads
+static const uint64_t MIN_EDGES_PER_THREAD = 1 << 14;
+
+BreadthFirstSearch::BreadthFirstSearch(){
+	alpha = 15;
+	beta = 18;
+	threadCount = 1;
+	runThreads = 1;
+	reachedCount = 0;
+}
+
+void BreadthFirstSearch::SetAlpha(unsigned alpha){
+	this->alpha = max(1u, alpha);
+}
+
+void BreadthFirstSearch::SetBeta(unsigned beta){
+	this->beta = max(1u, beta);
+}
+
+void BreadthFirstSearch::SetThreads(unsigned threadCount){
+	this->threadCount = threadCount;
+}
+
+void BreadthFirstSearch::Run(const CsrSnapshot& snapshot, size_t source){
+	Run(snapshot, vector<size_t>(1, source));
+}
+
+void BreadthFirstSearch::Run(const CsrSnapshot& snapshot, const vector<size_t>& sources){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	size_t words = (n + 63) / 64;			// Words of the bitmaps
+	runThreads = threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+	BuildIncoming(snapshot);
+	searchDistances = vector<atomic<uint32_t> >(n);
+	searchParents = vector<atomic<uint32_t> >(n);
+	for(size_t i = 0; i < n; i++){
+		searchDistances[i].store(UNREACHED, memory_order_relaxed);
+		searchParents[i].store(UNREACHED, memory_order_relaxed);
+	}
+	// Edges which bottom-up steps may still check : incoming edges of unvisited nodes
+	uint64_t unexploredEdges = incomingSources.size();
+	frontier.clear();
+	for(vector<size_t>::const_iterator source = sources.begin(); source != sources.end(); ++source){
+		if(*source >= n){
+			cout << "[WARNING] Source " << *source << " is not a node of the snapshot ; it has been ignored" << endl;
+			continue;
+		}
+		if(searchDistances[*source].load(memory_order_relaxed) == 0){
+			continue;
+		}
+		searchDistances[*source].store(0, memory_order_relaxed);
+		searchParents[*source].store(*source, memory_order_relaxed);
+		frontier.push_back(*source);
+		unexploredEdges -= incomingOffsets[*source + 1] - incomingOffsets[*source];
+	}
+	reachedCount = frontier.size();
+	size_t frontierCount = frontier.size();		// Number of nodes in the frontier
+	bool bottomUp = false;				// If the frontier is a bitmap
+	vector<vector<uint32_t> > nextParts(runThreads);	// Nodes reached by each thread in a top-down step
+	vector<size_t> reachedParts(runThreads);	// Nodes reached by each thread in a bottom-up step
+	vector<uint64_t> reachedEdgeParts(runThreads);	// Incoming edges of these nodes
+	for(uint32_t level = 0; frontierCount > 0; level++){
+		if(!bottomUp){
+			uint64_t frontierEdges = 0;
+			for(vector<uint32_t>::iterator node = frontier.begin(); node != frontier.end(); ++node){
+				frontierEdges += offsets[*node + 1] - offsets[*node];
+			}
+			// A large frontier would check more edges than the unvisited nodes have
+			if(frontierEdges > unexploredEdges / alpha){
+				frontierBits.assign(words, 0);
+				for(vector<uint32_t>::iterator node = frontier.begin(); node != frontier.end(); ++node){
+					frontierBits[*node / 64] |= (uint64_t) 1 << (*node % 64);
+				}
+				bottomUp = true;
+			}
+			else{
+				RunParallel(frontier.size(), frontierEdges, [this, &snapshot, &nextParts, level](unsigned t, size_t first, size_t last){
+					StepTopDown(snapshot, first, last, level, nextParts[t]);
+				});
+				frontier.clear();
+				for(unsigned t = 0; t < runThreads; t++){
+					frontier.insert(frontier.end(), nextParts[t].begin(), nextParts[t].end());
+					nextParts[t].clear();
+				}
+				for(vector<uint32_t>::iterator node = frontier.begin(); node != frontier.end(); ++node){
+					unexploredEdges -= incomingOffsets[*node + 1] - incomingOffsets[*node];
+				}
+				frontierCount = frontier.size();
+				reachedCount += frontierCount;
+				continue;
+			}
+		}
+		// Bottom-up step : ranges of whole words, so that each thread writes its own words
+		nextBits.assign(words, 0);
+		fill(reachedParts.begin(), reachedParts.end(), 0);
+		fill(reachedEdgeParts.begin(), reachedEdgeParts.end(), 0);
+		RunParallel(words, unexploredEdges, [this, &reachedParts, &reachedEdgeParts, level](unsigned t, size_t first, size_t last){
+			StepBottomUp(first, last, level, reachedParts[t], reachedEdgeParts[t]);
+		});
+		frontierBits.swap(nextBits);
+		frontierCount = 0;
+		for(unsigned t = 0; t < runThreads; t++){
+			frontierCount += reachedParts[t];
+			unexploredEdges -= reachedEdgeParts[t];
+		}
+		reachedCount += frontierCount;
+		// A small frontier is faster to expand from its own edges
+		if(frontierCount < n / beta){
+			frontier.clear();
+			for(size_t word = 0; word < words; word++){
+				for(uint64_t bits = frontierBits[word]; bits != 0; bits &= bits - 1){
+					frontier.push_back(word * 64 + __builtin_ctzll(bits));
+				}
+			}
+			bottomUp = false;
+		}
+	}
+	distances.resize(n);
+	parents.resize(n);
+	for(size_t i = 0; i < n; i++){
+		distances[i] = searchDistances[i].load(memory_order_relaxed);
+		parents[i] = searchParents[i].load(memory_order_relaxed);
+	}
+}
+
+const vector<uint32_t>& BreadthFirstSearch::GetDistances(){return distances;}
+const vector<uint32_t>& BreadthFirstSearch::GetParents(){return parents;}
+size_t BreadthFirstSearch::GetReachedCount(){return reachedCount;}
+
+void BreadthFirstSearch::BuildIncoming(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	// Counting sort of edges by target : sources come in increasing order for each target
+	incomingOffsets.assign(n + 1, 0);
+	for(vector<uint32_t>::const_iterator target = targets.begin(); target != targets.end(); ++target){
+		incomingOffsets[*target + 1]++;
+	}
+	for(size_t i = 0; i < n; i++){
+		incomingOffsets[i + 1] += incomingOffsets[i];
+	}
+	incomingSources.resize(targets.size());
+	vector<uint64_t> positions(incomingOffsets.begin(), incomingOffsets.end() - 1);
+	for(size_t i = 0; i < n; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			incomingSources[positions[targets[e]]++] = i;
+		}
+	}
+}
+
+void BreadthFirstSearch::StepTopDown(const CsrSnapshot& snapshot, size_t first, size_t last, uint32_t level, vector<uint32_t>& next){
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	for(size_t position = first; position < last; position++){
+		uint32_t node = frontier[position];
+		for(uint64_t e = offsets[node]; e < offsets[node + 1]; e++){
+			uint32_t target = targets[e];
+			uint32_t distance = searchDistances[target].load(memory_order_relaxed);
+			if(distance <= level){
+				continue;
+			}
+			// The first thread reaching a node adds it to the next frontier
+			if(distance == UNREACHED && searchDistances[target].compare_exchange_strong(distance, level + 1, memory_order_relaxed)){
+				next.push_back(target);
+			}
+			else if(distance != level + 1){
+				continue;
+			}
+			// The parent with the lowest index is kept, so the result does not depend on threads
+			uint32_t parent = searchParents[target].load(memory_order_relaxed);
+			while(node < parent && !searchParents[target].compare_exchange_weak(parent, node, memory_order_relaxed));
+		}
+	}
+}
+
+void BreadthFirstSearch::StepBottomUp(size_t firstWord, size_t lastWord, uint32_t level, size_t& reached, uint64_t& reachedEdges){
+	size_t n = searchDistances.size();
+	for(size_t word = firstWord; word < lastWord; word++){
+		for(size_t node = word * 64; node < min(n, word * 64 + 64); node++){
+			if(searchDistances[node].load(memory_order_relaxed) != UNREACHED){
+				continue;
+			}
+			// Incoming edges are sorted by source : the first one from the frontier is the lowest parent
+			for(uint64_t e = incomingOffsets[node]; e < incomingOffsets[node + 1]; e++){
+				uint32_t source = incomingSources[e];
+				if((frontierBits[source / 64] >> (source % 64)) & 1){
+					searchDistances[node].store(level + 1, memory_order_relaxed);
+					searchParents[node].store(source, memory_order_relaxed);
+					nextBits[word] |= (uint64_t) 1 << (node % 64);
+					reached++;
+					reachedEdges += incomingOffsets[node + 1] - incomingOffsets[node];
+					break;
+				}
+			}
+		}
+	}
+}
+
+void BreadthFirstSearch::RunParallel(size_t itemCount, uint64_t work, const function<void(unsigned, size_t, size_t)>& step){
+	unsigned threads = (unsigned) min((uint64_t) runThreads, max((uint64_t) 1, work / MIN_EDGES_PER_THREAD));
+	threads = (unsigned) min((size_t) threads, max((size_t) 1, itemCount));
+	if(threads <= 1){
+		step(0, 0, itemCount);
+		return;
+	}
+	size_t block = (itemCount + threads - 1) / threads;
+	vector<thread> workers;
+	for(unsigned t = 0; t < threads; t++){
+		size_t first = min(itemCount, t * block);
+		size_t last = min(itemCount, first + block);
+		workers.push_back(thread(step, t, first, last));
+	}
+	for(vector<thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker){
+		worker->join();
+	}
+}
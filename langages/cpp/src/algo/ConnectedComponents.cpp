@@ -0,0 +1,176 @@
+#include "../../include/algo/ConnectedComponents.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+// Index of a node which has not been visited by Tarjan's algorithm
+static const uint32_t UNVISITED = 0xFFFFFFFF;
+
+// Edges below which merging is not worth a thread
+static const uint64_t MIN_EDGES_PER_THREAD = 1 << 14;
+
+ConnectedComponents::ConnectedComponents(){
+	threadCount = 1;
+}
+
+void ConnectedComponents::SetThreads(unsigned threadCount){
+	this->threadCount = threadCount;
+}
+
+void ConnectedComponents::RunWeak(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	unsigned threads = threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+	threads = (unsigned) min((uint64_t) threads, max((uint64_t) 1, snapshot.GetEdgeCount() / MIN_EDGES_PER_THREAD));
+	setParents = vector<atomic<uint32_t> >(n);
+	for(size_t i = 0; i < n; i++){
+		setParents[i].store(i, memory_order_relaxed);
+	}
+	if(threads <= 1){
+		MergeRange(snapshot, 0, n);
+	}
+	else{
+		// Ranges hold the same number of edges, not of nodes
+		vector<thread> workers;
+		size_t first = 0;
+		for(unsigned t = 0; t < threads; t++){
+			uint64_t limit = snapshot.GetEdgeCount() * (t + 1) / threads;
+			size_t last = t + 1 == threads ? n : (size_t) (upper_bound(offsets.begin(), offsets.end(), limit) - offsets.begin() - 1);
+			last = max(first, last);
+			workers.push_back(thread(&ConnectedComponents::MergeRange, this, ref(snapshot), first, last));
+			first = last;
+		}
+		for(vector<thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker){
+			worker->join();
+		}
+	}
+	// Roots are the lowest node of their set, so they are met before the other nodes of their set
+	components.resize(n);
+	sizes.clear();
+	for(size_t i = 0; i < n; i++){
+		uint32_t root = Find(i);
+		if(root == i){
+			components[i] = sizes.size();
+			sizes.push_back(0);
+		}
+		else{
+			components[i] = components[root];
+		}
+		sizes[components[i]]++;
+	}
+	setParents.clear();
+}
+
+void ConnectedComponents::RunStrong(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	vector<uint32_t> order(n, UNVISITED);	// Visit order of each node
+	vector<uint32_t> low(n);			// Lowest visit order reachable from the subtree of each node
+	vector<bool> onStack(n, false);		// If each node is on the stack of open components
+	vector<uint32_t> stack;			// Nodes whose component is not known yet
+	vector<Visit> calls;			// Explicit call stack of the depth-first search
+	uint32_t counter = 0;			// Next visit order
+	components.assign(n, 0);
+	sizes.clear();
+	for(size_t root = 0; root < n; root++){
+		if(order[root] != UNVISITED){
+			continue;
+		}
+		Visit visit;
+		visit.node = root;
+		visit.edge = offsets[root];
+		calls.push_back(visit);
+		order[root] = low[root] = counter++;
+		stack.push_back(root);
+		onStack[root] = true;
+		while(!calls.empty()){
+			uint32_t node = calls.back().node;
+			// Follow the next edge of the node on top of the call stack
+			if(calls.back().edge < offsets[node + 1]){
+				uint32_t next = targets[calls.back().edge++];
+				if(order[next] == UNVISITED){
+					visit.node = next;
+					visit.edge = offsets[next];
+					calls.push_back(visit);
+					order[next] = low[next] = counter++;
+					stack.push_back(next);
+					onStack[next] = true;
+				}
+				else if(onStack[next]){
+					low[node] = min(low[node], order[next]);
+				}
+				continue;
+			}
+			// All edges followed : return to the caller
+			calls.pop_back();
+			if(!calls.empty()){
+				low[calls.back().node] = min(low[calls.back().node], low[node]);
+			}
+			if(low[node] != order[node]){
+				continue;
+			}
+			// The node is the first visited of its component : the component is on the stack above it
+			uint32_t member;
+			do{
+				member = stack.back();
+				stack.pop_back();
+				onStack[member] = false;
+				components[member] = sizes.size();
+			}while(member != node);
+			sizes.push_back(0);
+		}
+	}
+	for(size_t i = 0; i < n; i++){
+		sizes[components[i]]++;
+	}
+}
+
+const vector<uint32_t>& ConnectedComponents::GetComponents(){return components;}
+const vector<size_t>& ConnectedComponents::GetSizes(){return sizes;}
+size_t ConnectedComponents::GetComponentCount(){return sizes.size();}
+
+void ConnectedComponents::MergeRange(const CsrSnapshot& snapshot, size_t first, size_t last){
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	for(size_t i = first; i < last; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			Union(i, targets[e]);
+		}
+	}
+}
+
+uint32_t ConnectedComponents::Find(uint32_t node){
+	while(true){
+		uint32_t parent = setParents[node].load(memory_order_relaxed);
+		if(parent == node){
+			return node;
+		}
+		uint32_t grandParent = setParents[parent].load(memory_order_relaxed);
+		// Path halving : a failed exchange only means another thread has shortened the path first
+		if(grandParent != parent){
+			setParents[node].compare_exchange_weak(parent, grandParent, memory_order_relaxed);
+		}
+		node = grandParent;
+	}
+}
+
+void ConnectedComponents::Union(uint32_t a, uint32_t b){
+	while(true){
+		a = Find(a);
+		b = Find(b);
+		if(a == b){
+			return;
+		}
+		// Links always go to a lower index, so no cycle can appear
+		if(a < b){
+			swap(a, b);
+		}
+		uint32_t expected = a;
+		if(setParents[a].compare_exchange_strong(expected, b, memory_order_relaxed)){
+			return;
+		}
+	}
+}
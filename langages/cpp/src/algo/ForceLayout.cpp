@@ -0,0 +1,283 @@
+#include "../../include/algo/ForceLayout.h"
+#include "../../include/io/WorkerPool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <math.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+// Depth limit of the quadtree : nodes at the same place end in the same leaf
+static const int MAX_DEPTH = 32;
+
+// Golden angle, used to spread nodes on a spiral
+static const float GOLDEN_ANGLE = 2.39996323f;
+
+// Nodes below which forces are not worth threads
+static const size_t MIN_NODES_PER_THREAD = 4096;
+
+// Work of the repulsion of one node, counted in neighbours (the walk in the quadtree visits several cells)
+static const uint64_t REPULSION_WEIGHT = 16;
+
+ForceLayout::ForceLayout(){
+	iterations = 300;
+	distance = 80;
+	theta = 0.8f;
+	threadCount = 1;
+}
+
+void ForceLayout::SetIterations(unsigned iterations){
+	this->iterations = iterations;
+}
+
+void ForceLayout::SetDistance(float distance){
+	this->distance = distance;
+}
+
+void ForceLayout::SetTheta(float theta){
+	this->theta = theta;
+}
+
+void ForceLayout::SetThreads(unsigned threadCount){
+	this->threadCount = threadCount;
+}
+
+vector<float> ForceLayout::Run(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	vector<float> positions = snapshot.GetCoordinates();
+	const vector<uint8_t>& fixed = snapshot.GetFixed();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	// Neighbours in both directions (loops do not move anything)
+	neighbourOffsets.assign(n + 1, 0);
+	for(size_t i = 0; i < n; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			if(targets[e] != i){
+				neighbourOffsets[i + 1]++;
+				neighbourOffsets[targets[e] + 1]++;
+			}
+		}
+	}
+	for(size_t i = 0; i < n; i++){
+		neighbourOffsets[i + 1] += neighbourOffsets[i];
+	}
+	neighbours.resize(neighbourOffsets[n]);
+	vector<uint64_t> next(neighbourOffsets.begin(), neighbourOffsets.end() - 1);
+	for(size_t i = 0; i < n; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			if(targets[e] != i){
+				neighbours[next[i]++] = targets[e];
+				neighbours[next[targets[e]]++] = i;
+			}
+		}
+	}
+	// Free nodes start on a spiral around fixed nodes : the layout is the same at each run
+	double centerX = 0;
+	double centerY = 0;
+	size_t fixedCount = 0;
+	for(size_t i = 0; i < n; i++){
+		if(fixed[i]){
+			centerX += positions[2 * i];
+			centerY += positions[2 * i + 1];
+			fixedCount++;
+		}
+	}
+	if(fixedCount == n){
+		return positions;
+	}
+	if(fixedCount > 0){
+		centerX /= fixedCount;
+		centerY /= fixedCount;
+	}
+	size_t freeCount = 0;
+	for(size_t i = 0; i < n; i++){
+		if(!fixed[i]){
+			float radius = distance * sqrt((float) freeCount);
+			positions[2 * i] = centerX + radius * cos(GOLDEN_ANGLE * freeCount);
+			positions[2 * i + 1] = centerY + radius * sin(GOLDEN_ANGLE * freeCount);
+			freeCount++;
+		}
+	}
+	// Nodes cannot move further than the temperature, which decreases at each iteration
+	unsigned threads = threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+	threads = (unsigned) min((size_t) threads, max((size_t) 1, n / MIN_NODES_PER_THREAD));
+	// Ranges of consecutive nodes with about the same work : a node weighs its repulsion, plus its neighbours
+	vector<size_t> firstNodes(threads + 1, n);
+	firstNodes[0] = 0;
+	uint64_t totalWeight = REPULSION_WEIGHT * n + neighbourOffsets[n];
+	uint64_t weight = 0;
+	unsigned range = 1;
+	for(size_t i = 0; i < n && range < threads; i++){
+		weight += REPULSION_WEIGHT + neighbourOffsets[i + 1] - neighbourOffsets[i];
+		for(; range < threads && weight >= totalWeight * range / threads; range++){
+			firstNodes[range] = i + 1;
+		}
+	}
+	// Threads are started once for all iterations, the calling thread computes the first range
+	shared_ptr<WorkerPool> pool;
+	if(threads > 1){
+		pool = make_shared<WorkerPool>(threads - 1);
+	}
+	mutex pendingLock;
+	condition_variable rangesDone;
+	float startTemperature = distance * max(1.0f, sqrt((float) n) / 10);
+	vector<float> displacements(2 * n);
+	for(unsigned iteration = 0; iteration < iterations; iteration++){
+		BuildTree(positions);
+		if(threads == 1){
+			ComputeForces(positions, 0, n, displacements);
+		}
+		else{
+			unsigned pending = threads - 1;
+			for(unsigned t = 1; t < threads; t++){
+				size_t first = firstNodes[t];
+				size_t last = firstNodes[t + 1];
+				pool->Submit([this, &positions, &displacements, &pendingLock, &rangesDone, &pending, first, last](){
+					ComputeForces(positions, first, last, displacements);
+					lock_guard<mutex> lock(pendingLock);
+					pending--;
+					rangesDone.notify_one();
+				});
+			}
+			ComputeForces(positions, firstNodes[0], firstNodes[1], displacements);
+			unique_lock<mutex> lock(pendingLock);
+			rangesDone.wait(lock, [&pending](){return pending == 0;});
+		}
+		float temperature = startTemperature * (1 - (float) iteration / iterations);
+		for(size_t i = 0; i < n; i++){
+			if(fixed[i]){
+				continue;
+			}
+			float dx = displacements[2 * i];
+			float dy = displacements[2 * i + 1];
+			float length = sqrt(dx * dx + dy * dy);
+			if(length > temperature){
+				dx *= temperature / length;
+				dy *= temperature / length;
+			}
+			positions[2 * i] += dx;
+			positions[2 * i + 1] += dy;
+		}
+	}
+	cells.clear();
+	return positions;
+}
+
+void ForceLayout::BuildTree(const vector<float>& positions){
+	size_t n = positions.size() / 2;
+	float minX = positions[0];
+	float minY = positions[1];
+	float maxX = minX;
+	float maxY = minY;
+	for(size_t i = 1; i < n; i++){
+		minX = min(minX, positions[2 * i]);
+		maxX = max(maxX, positions[2 * i]);
+		minY = min(minY, positions[2 * i + 1]);
+		maxY = max(maxY, positions[2 * i + 1]);
+	}
+	QuadCell root = {minX, minY, max(max(maxX - minX, maxY - minY) * 1.001f, distance), 0, 0, 0, -1, -1};
+	cells.clear();
+	cells.push_back(root);
+	for(size_t i = 0; i < n; i++){
+		float x = positions[2 * i];
+		float y = positions[2 * i + 1];
+		int32_t c = 0;
+		// Cells are referenced by index : the vector may grow while descending
+		for(int depth = 0; ; depth++){
+			cells[c].mass++;
+			cells[c].sumX += x;
+			cells[c].sumY += y;
+			if(cells[c].children < 0){
+				if(cells[c].mass == 1){
+					cells[c].body = i;
+					break;
+				}
+				if(depth >= MAX_DEPTH){
+					cells[c].body = -2;
+					break;
+				}
+				// Split the leaf and move its node into a child
+				int32_t first = cells.size();
+				float half = cells[c].size / 2;
+				for(int q = 0; q < 4; q++){
+					QuadCell child = {cells[c].x + (q & 1) * half, cells[c].y + (q >> 1) * half, half, 0, 0, 0, -1, -1};
+					cells.push_back(child);
+				}
+				int32_t body = cells[c].body;
+				float bodyX = positions[2 * body];
+				float bodyY = positions[2 * body + 1];
+				int32_t bodyCell = first + (bodyX >= cells[c].x + half ? 1 : 0) + (bodyY >= cells[c].y + half ? 2 : 0);
+				cells[bodyCell].mass = 1;
+				cells[bodyCell].sumX = bodyX;
+				cells[bodyCell].sumY = bodyY;
+				cells[bodyCell].body = body;
+				cells[c].children = first;
+				cells[c].body = -1;
+			}
+			float half = cells[c].size / 2;
+			c = cells[c].children + (x >= cells[c].x + half ? 1 : 0) + (y >= cells[c].y + half ? 2 : 0);
+		}
+	}
+	// Sums become centers of mass
+	for(vector<QuadCell>::iterator cell = cells.begin(); cell != cells.end(); ++cell){
+		if(cell->mass > 0){
+			cell->sumX /= cell->mass;
+			cell->sumY /= cell->mass;
+		}
+	}
+}
+
+void ForceLayout::ComputeForces(const vector<float>& positions, size_t first, size_t last, vector<float>& displacements){
+	float k2 = distance * distance;
+	float theta2 = theta * theta;
+	int32_t stack[4 * MAX_DEPTH + 8];
+	for(size_t i = first; i < last; i++){
+		float x = positions[2 * i];
+		float y = positions[2 * i + 1];
+		float forceX = 0;
+		float forceY = 0;
+		// Repulsion k^2/d from every node, far groups of nodes seen as one node
+		int top = 0;
+		stack[top++] = 0;
+		while(top > 0){
+			const QuadCell& cell = cells[stack[--top]];
+			if(cell.mass == 0 || cell.body == (int32_t) i){
+				continue;
+			}
+			float dx = x - cell.sumX;
+			float dy = y - cell.sumY;
+			float d2 = dx * dx + dy * dy;
+			if(cell.children >= 0 && cell.size * cell.size >= theta2 * d2){
+				for(int q = 0; q < 4; q++){
+					stack[top++] = cell.children + q;
+				}
+				continue;
+			}
+			float mass = cell.mass;
+			// Nodes at the same place are pushed away in a direction depending on the node
+			if(d2 < 1e-6f * k2){
+				if(cell.body == -2){
+					mass--;
+				}
+				dx = 0.01f * distance * cos(GOLDEN_ANGLE * i);
+				dy = 0.01f * distance * sin(GOLDEN_ANGLE * i);
+				d2 = dx * dx + dy * dy;
+			}
+			forceX += dx * k2 * mass / d2;
+			forceY += dy * k2 * mass / d2;
+		}
+		// Attraction d^2/k along edges
+		for(uint64_t e = neighbourOffsets[i]; e < neighbourOffsets[i + 1]; e++){
+			float dx = x - positions[2 * neighbours[e]];
+			float dy = y - positions[2 * neighbours[e] + 1];
+			float d = sqrt(dx * dx + dy * dy);
+			forceX -= dx * d / distance;
+			forceY -= dy * d / distance;
+		}
+		displacements[2 * i] = forceX;
+		displacements[2 * i + 1] = forceY;
+	}
+}
@@ -0,0 +1,203 @@
+#include "../../include/algo/GraphGenerator.h"
+
+#include <algorithm>
+#include <math.h>
+#include <unordered_map>
+
+using namespace std;
+
+GraphGenerator::GraphGenerator(){
+	seed = 0;
+	areaSize = 1000;
+	shuffle = false;
+	SetRmatProbabilities(0.57, 0.19, 0.19);
+}
+
+void GraphGenerator::SetSeed(uint64_t seed){
+	this->seed = seed;
+}
+
+void GraphGenerator::SetAreaSize(float areaSize){
+	this->areaSize = areaSize;
+}
+
+void GraphGenerator::SetRmatProbabilities(double a, double b, double c){
+	if(!(a >= 0 && b >= 0 && c >= 0 && a + b + c <= 1)){
+		cout << "[WARNING] R-MAT probabilities " << a << ", " << b << " and " << c << " are not probabilities of a quarter ; they have been ignored" << endl;
+		return;
+	}
+	rmatProbabilities[0] = a;
+	rmatProbabilities[1] = b;
+	rmatProbabilities[2] = c;
+}
+
+void GraphGenerator::SetShuffle(bool enabled){
+	shuffle = enabled;
+}
+
+CsrSnapshot GraphGenerator::ErdosRenyi(size_t nodeCount, size_t edgeCount){
+	generator.seed(seed);
+	vector<pair<uint32_t, uint32_t> > edgeList;
+	vector<float> coordinates;
+	if(nodeCount > 1){
+		edgeList.reserve(edgeCount);
+		for(size_t i = 0; i < edgeCount; i++){
+			uint32_t from = NextIndex(nodeCount);
+			// The target is drawn among the other nodes
+			uint32_t to = NextIndex(nodeCount - 1);
+			edgeList.push_back(make_pair(from, to < from ? to : to + 1));
+		}
+	}
+	return Finish(nodeCount, edgeList, coordinates);
+}
+
+CsrSnapshot GraphGenerator::Rmat(unsigned scale, size_t edgeCount){
+	generator.seed(seed);
+	scale = min(scale, 31u);
+	size_t nodeCount = (size_t) 1 << scale;
+	vector<pair<uint32_t, uint32_t> > edgeList;
+	vector<float> coordinates;
+	edgeList.reserve(edgeCount);
+	for(size_t i = 0; i < edgeCount; i++){
+		uint32_t from = 0, to = 0;
+		// Each level picks a quarter of the current block of the matrix : one bit of the source and one bit of the target
+		for(unsigned level = 0; level < scale; level++){
+			double draw = NextReal();
+			bool bottom = draw >= rmatProbabilities[0] + rmatProbabilities[1];
+			bool right = bottom ? draw >= rmatProbabilities[0] + rmatProbabilities[1] + rmatProbabilities[2] : draw >= rmatProbabilities[0];
+			from = (from << 1) | (bottom ? 1 : 0);
+			to = (to << 1) | (right ? 1 : 0);
+		}
+		edgeList.push_back(make_pair(from, to));
+	}
+	return Finish(nodeCount, edgeList, coordinates);
+}
+
+CsrSnapshot GraphGenerator::Grid(size_t width, size_t height){
+	generator.seed(seed);
+	size_t nodeCount = width * height;
+	double spacing = max(width, height) > 1 ? (double) areaSize / (max(width, height) - 1) : 0;	// Distance between neighbours
+	vector<pair<uint32_t, uint32_t> > edgeList;
+	vector<float> coordinates(2 * nodeCount);
+	edgeList.reserve(4 * nodeCount);
+	for(size_t i = 0; i < nodeCount; i++){
+		coordinates[2 * i] = (i % width) * spacing;
+		coordinates[2 * i + 1] = (i / width) * spacing;
+		if(i % width + 1 < width){
+			edgeList.push_back(make_pair((uint32_t) i, (uint32_t) (i + 1)));
+			edgeList.push_back(make_pair((uint32_t) (i + 1), (uint32_t) i));
+		}
+		if(i + width < nodeCount){
+			edgeList.push_back(make_pair((uint32_t) i, (uint32_t) (i + width)));
+			edgeList.push_back(make_pair((uint32_t) (i + width), (uint32_t) i));
+		}
+	}
+	return Finish(nodeCount, edgeList, coordinates);
+}
+
+CsrSnapshot GraphGenerator::RandomGeometric(size_t nodeCount, float radius){
+	generator.seed(seed);
+	vector<pair<uint32_t, uint32_t> > edgeList;
+	vector<float> coordinates(2 * nodeCount);
+	for(size_t i = 0; i < 2 * nodeCount; i++){
+		coordinates[i] = NextReal() * areaSize;
+	}
+	// Nodes are bucketed in cells as wide as the radius : close nodes are in the same cell or in a neighbouring one
+	double cellSize = max((double) radius, (double) areaSize / 65536);
+	if(!(cellSize > 0)){
+		cellSize = 1;
+	}
+	size_t side = (size_t) ceil(areaSize / cellSize) + 1;	// Number of cells on a side
+	unordered_map<uint64_t, vector<uint32_t> > cells;
+	for(size_t i = 0; i < nodeCount; i++){
+		uint64_t column = coordinates[2 * i] / cellSize;
+		uint64_t row = coordinates[2 * i + 1] / cellSize;
+		cells[row * side + column].push_back(i);
+	}
+	double limit = (double) radius * radius;	// Greatest squared distance
+	for(size_t i = 0; i < nodeCount; i++){
+		int64_t column = coordinates[2 * i] / cellSize;
+		int64_t row = coordinates[2 * i + 1] / cellSize;
+		for(int64_t r = max(row - 1, (int64_t) 0); r <= min(row + 1, (int64_t) side - 1); r++){
+			for(int64_t c = max(column - 1, (int64_t) 0); c <= min(column + 1, (int64_t) side - 1); c++){
+				unordered_map<uint64_t, vector<uint32_t> >::iterator cell = cells.find(r * side + c);
+				if(cell == cells.end()){
+					continue;
+				}
+				// Each pair is found from its lowest node, and linked both ways
+				for(vector<uint32_t>::iterator other = cell->second.begin(); other != cell->second.end(); ++other){
+					double dx = (double) coordinates[2 * *other] - coordinates[2 * i];
+					double dy = (double) coordinates[2 * *other + 1] - coordinates[2 * i + 1];
+					if(*other > i && dx * dx + dy * dy <= limit){
+						edgeList.push_back(make_pair((uint32_t) i, *other));
+						edgeList.push_back(make_pair(*other, (uint32_t) i));
+					}
+				}
+			}
+		}
+	}
+	return Finish(nodeCount, edgeList, coordinates);
+}
+
+CsrSnapshot GraphGenerator::PowerLaw(size_t nodeCount, size_t edgesPerNode){
+	generator.seed(seed);
+	vector<pair<uint32_t, uint32_t> > edgeList;
+	vector<float> coordinates;
+	vector<uint32_t> ends;				// Both ends of each edge : a node appears once per edge, so a uniform draw follows degrees
+	edgeList.reserve(nodeCount * edgesPerNode);
+	ends.reserve(2 * nodeCount * edgesPerNode);
+	vector<uint32_t> targets;			// Targets of the current node
+	for(size_t i = 1; i < nodeCount; i++){
+		targets.clear();
+		size_t wanted = min(edgesPerNode, i);
+		// Targets are distinct : a few draws are allowed per target, then the node keeps fewer edges
+		for(size_t attempt = 0; targets.size() < wanted && attempt < 4 * wanted; attempt++){
+			uint32_t target = ends.empty() ? NextIndex(i) : ends[NextIndex(ends.size())];
+			if(find(targets.begin(), targets.end(), target) == targets.end()){
+				targets.push_back(target);
+			}
+		}
+		for(vector<uint32_t>::iterator target = targets.begin(); target != targets.end(); ++target){
+			edgeList.push_back(make_pair((uint32_t) i, *target));
+			ends.push_back(i);
+			ends.push_back(*target);
+		}
+	}
+	return Finish(nodeCount, edgeList, coordinates);
+}
+
+uint64_t GraphGenerator::NextIndex(uint64_t count){
+	return generator() % count;
+}
+
+double GraphGenerator::NextReal(){
+	// 53 random bits fill the mantissa of a double
+	return (generator() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+CsrSnapshot GraphGenerator::Finish(size_t nodeCount, vector<pair<uint32_t, uint32_t> >& edgeList, vector<float>& coordinates){
+	if(!shuffle){
+		return CsrSnapshot(nodeCount, edgeList, coordinates);
+	}
+	// Fisher-Yates shuffle of node indexes, then edges and positions follow their nodes
+	vector<uint32_t> indexes(nodeCount);
+	for(size_t i = 0; i < nodeCount; i++){
+		indexes[i] = i;
+	}
+	for(size_t i = nodeCount; i > 1; i--){
+		swap(indexes[i - 1], indexes[NextIndex(i)]);
+	}
+	for(vector<pair<uint32_t, uint32_t> >::iterator edge = edgeList.begin(); edge != edgeList.end(); ++edge){
+		edge->first = indexes[edge->first];
+		edge->second = indexes[edge->second];
+	}
+	if(!coordinates.empty()){
+		vector<float> shuffled(coordinates.size());
+		for(size_t i = 0; i < nodeCount; i++){
+			shuffled[2 * indexes[i]] = coordinates[2 * i];
+			shuffled[2 * indexes[i] + 1] = coordinates[2 * i + 1];
+		}
+		coordinates.swap(shuffled);
+	}
+	return CsrSnapshot(nodeCount, edgeList, coordinates);
+}
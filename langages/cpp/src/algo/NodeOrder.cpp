@@ -0,0 +1,235 @@
+#include "../../include/algo/NodeOrder.h"
+
+#include <algorithm>
+#include <math.h>
+
+using namespace std;
+
+// Number of cells on a side of the grid of the Hilbert curve
+static const uint32_t HILBERT_SIDE = 1 << 16;
+
+NodeOrder::NodeOrder(){
+	method = REVERSE_CUTHILL_MCKEE;
+}
+
+void NodeOrder::SetMethod(Method method){
+	this->method = method;
+}
+
+void NodeOrder::Run(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	order.clear();
+	order.reserve(n);
+	ordered.assign(n, false);
+	if(method == HILBERT){
+		RunHilbert(snapshot);
+	}
+	else{
+		FindNeighbours(snapshot);
+	}
+	if(method == DEGREE){
+		for(size_t i = 0; i < n; i++){
+			order.push_back(i);
+		}
+		stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b){
+			return neighbourOffsets[a + 1] - neighbourOffsets[a] > neighbourOffsets[b + 1] - neighbourOffsets[b];
+		});
+	}
+	else if(method == BREADTH_FIRST){
+		for(size_t i = 0; i < n; i++){
+			if(!ordered[i]){
+				AddSearch(i, false);
+			}
+		}
+	}
+	else if(method == REVERSE_CUTHILL_MCKEE){
+		// Each component starts from a peripheral node, components with the loneliest nodes first
+		vector<uint32_t> candidates(n);
+		for(size_t i = 0; i < n; i++){
+			candidates[i] = i;
+		}
+		stable_sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b){
+			return neighbourOffsets[a + 1] - neighbourOffsets[a] < neighbourOffsets[b + 1] - neighbourOffsets[b];
+		});
+		for(vector<uint32_t>::iterator candidate = candidates.begin(); candidate != candidates.end(); ++candidate){
+			if(!ordered[*candidate]){
+				AddSearch(FindPeripheralNode(*candidate), true);
+			}
+		}
+		reverse(order.begin(), order.end());
+	}
+	positions.resize(n);
+	for(size_t i = 0; i < n; i++){
+		positions[order[i]] = i;
+	}
+	// Lists of neighbours are only needed during the run
+	vector<uint64_t>().swap(neighbourOffsets);
+	vector<uint32_t>().swap(neighbours);
+	vector<bool>().swap(ordered);
+}
+
+const vector<uint32_t>& NodeOrder::GetOrder(){return order;}
+const vector<uint32_t>& NodeOrder::GetPositions(){return positions;}
+
+double NodeOrder::ComputeAverageGap(const CsrSnapshot& snapshot, const vector<uint32_t>& positions){
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	if(targets.empty()){
+		return 0;
+	}
+	double sum = 0;
+	for(size_t i = 0; i < snapshot.GetNodeCount(); i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			double from = positions.empty() ? i : positions[i];
+			double to = positions.empty() ? targets[e] : positions[targets[e]];
+			sum += fabs(from - to);
+		}
+	}
+	return sum / targets.size();
+}
+
+void NodeOrder::FindNeighbours(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	// Each edge is a neighbour of both its nodes : lists are filled by counting sort
+	neighbourOffsets.assign(n + 1, 0);
+	for(size_t i = 0; i < n; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			neighbourOffsets[i + 1]++;
+			neighbourOffsets[targets[e] + 1]++;
+		}
+	}
+	for(size_t i = 0; i < n; i++){
+		neighbourOffsets[i + 1] += neighbourOffsets[i];
+	}
+	neighbours.resize(2 * targets.size());
+	vector<uint64_t> next(neighbourOffsets.begin(), neighbourOffsets.end() - 1);
+	for(size_t i = 0; i < n; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			neighbours[next[i]++] = targets[e];
+			neighbours[next[targets[e]]++] = i;
+		}
+	}
+}
+
+void NodeOrder::AddSearch(uint32_t start, bool byDegree){
+	// The order itself is the queue of the search
+	order.push_back(start);
+	ordered[start] = true;
+	for(size_t head = order.size() - 1; head < order.size(); head++){
+		uint32_t node = order[head];
+		size_t first = order.size();		// Position of the first neighbour added by this node
+		for(uint64_t k = neighbourOffsets[node]; k < neighbourOffsets[node + 1]; k++){
+			uint32_t next = neighbours[k];
+			if(!ordered[next]){
+				ordered[next] = true;
+				order.push_back(next);
+			}
+		}
+		if(byDegree){
+			stable_sort(order.begin() + first, order.end(), [this](uint32_t a, uint32_t b){
+				return neighbourOffsets[a + 1] - neighbourOffsets[a] < neighbourOffsets[b + 1] - neighbourOffsets[b];
+			});
+		}
+	}
+}
+
+uint32_t NodeOrder::FindPeripheralNode(uint32_t start){
+	vector<uint32_t> queue;				// Nodes reached by the search, level by level
+	vector<uint32_t> levels;			// Level of each reached node, in order of the queue
+	vector<bool>& reached = ordered;		// Nodes of the component are not ordered yet : marks are borrowed, then cleared
+	uint32_t node = start;
+	uint32_t eccentricity = 0;			// Greatest level of the last search
+	for(; ; ){
+		queue.assign(1, node);
+		levels.assign(1, 0);
+		reached[node] = true;
+		for(size_t head = 0; head < queue.size(); head++){
+			for(uint64_t k = neighbourOffsets[queue[head]]; k < neighbourOffsets[queue[head] + 1]; k++){
+				uint32_t next = neighbours[k];
+				if(!reached[next]){
+					reached[next] = true;
+					queue.push_back(next);
+					levels.push_back(levels[head] + 1);
+				}
+			}
+		}
+		for(vector<uint32_t>::iterator reachedNode = queue.begin(); reachedNode != queue.end(); ++reachedNode){
+			reached[*reachedNode] = false;
+		}
+		// A farther node has been found : search again from the node of the last level with the fewest neighbours
+		if(levels.back() <= eccentricity){
+			return node;
+		}
+		eccentricity = levels.back();
+		size_t best = queue.size() - 1;
+		for(size_t i = queue.size() - 1; i > 0 && levels[i - 1] == eccentricity; i--){
+			uint32_t candidate = queue[i - 1];
+			if(neighbourOffsets[candidate + 1] - neighbourOffsets[candidate] <= neighbourOffsets[queue[best] + 1] - neighbourOffsets[queue[best]]){
+				best = i - 1;
+			}
+		}
+		node = queue[best];
+	}
+}
+
+void NodeOrder::RunHilbert(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<float>& coordinates = snapshot.GetCoordinates();
+	const vector<uint8_t>& fixed = snapshot.GetFixed();
+	float minX = 0, minY = 0, maxX = 0, maxY = 0;	// Bounds of fixed nodes
+	bool anyFixed = false;
+	for(size_t i = 0; i < n; i++){
+		if(!fixed[i]){
+			continue;
+		}
+		if(!anyFixed){
+			minX = maxX = coordinates[2 * i];
+			minY = maxY = coordinates[2 * i + 1];
+			anyFixed = true;
+		}
+		minX = min(minX, coordinates[2 * i]);
+		maxX = max(maxX, coordinates[2 * i]);
+		minY = min(minY, coordinates[2 * i + 1]);
+		maxY = max(maxY, coordinates[2 * i + 1]);
+	}
+	// The square grid covers the bounds, so the curve does not stretch one axis
+	double side = max((double) maxX - minX, (double) maxY - minY);
+	double cellsPerUnit = side > 0 ? (HILBERT_SIDE - 1) / side : 0;
+	vector<pair<uint64_t, uint32_t> > keys;		// Distance on the curve of each fixed node
+	for(size_t i = 0; i < n; i++){
+		if(fixed[i]){
+			uint32_t x = (uint32_t) min((double) HILBERT_SIDE - 1, max(0.0, ((double) coordinates[2 * i] - minX) * cellsPerUnit));
+			uint32_t y = (uint32_t) min((double) HILBERT_SIDE - 1, max(0.0, ((double) coordinates[2 * i + 1] - minY) * cellsPerUnit));
+			keys.push_back(make_pair(HilbertDistance(x, y), (uint32_t) i));
+		}
+	}
+	sort(keys.begin(), keys.end());
+	for(vector<pair<uint64_t, uint32_t> >::iterator key = keys.begin(); key != keys.end(); ++key){
+		order.push_back(key->second);
+	}
+	for(size_t i = 0; i < n; i++){
+		if(!fixed[i]){
+			order.push_back(i);
+		}
+	}
+}
+
+uint64_t NodeOrder::HilbertDistance(uint32_t x, uint32_t y){
+	uint64_t distance = 0;
+	for(uint32_t half = HILBERT_SIDE / 2; half > 0; half /= 2){
+		uint32_t right = (x & half) > 0 ? 1 : 0;
+		uint32_t bottom = (y & half) > 0 ? 1 : 0;
+		distance += (uint64_t) half * half * ((3 * right) ^ bottom);
+		// The quadrant is rotated so the curve inside it starts at its corner
+		if(bottom == 0){
+			if(right == 1){
+				x = HILBERT_SIDE - 1 - x;
+				y = HILBERT_SIDE - 1 - y;
+			}
+			swap(x, y);
+		}
+	}
+	return distance;
+}
@@ -0,0 +1,140 @@
+#include "../../include/algo/PageRank.h"
+
+#include <algorithm>
+#include <math.h>
+#include <thread>
+
+using namespace std;
+
+// Nodes of a block : blocks are shared between threads and have their own partial sums
+static const size_t BLOCK_SIZE = 4096;
+
+PageRank::PageRank(){
+	damping = 0.85;
+	tolerance = 1e-6;
+	maxIterations = 100;
+	threadCount = 1;
+	iterations = 0;
+}
+
+void PageRank::SetDamping(double damping){
+	this->damping = min(1.0, max(0.0, damping));
+}
+
+void PageRank::SetTolerance(double tolerance){
+	this->tolerance = tolerance;
+}
+
+void PageRank::SetMaxIterations(unsigned maxIterations){
+	this->maxIterations = maxIterations;
+}
+
+void PageRank::SetThreads(unsigned threadCount){
+	this->threadCount = threadCount;
+}
+
+bool PageRank::Run(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	iterations = 0;
+	ranks.assign(n, n == 0 ? 0 : 1.0 / n);
+	if(n == 0){
+		return true;
+	}
+	// Incoming edges by counting sort : each node pulls its rank, so threads only write their own nodes
+	vector<uint64_t> incomingOffsets(n + 1, 0);
+	for(vector<uint32_t>::const_iterator target = targets.begin(); target != targets.end(); ++target){
+		incomingOffsets[*target + 1]++;
+	}
+	for(size_t i = 0; i < n; i++){
+		incomingOffsets[i + 1] += incomingOffsets[i];
+	}
+	vector<uint32_t> incomingSources(targets.size());
+	vector<uint64_t> next(incomingOffsets.begin(), incomingOffsets.end() - 1);
+	for(size_t i = 0; i < n; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			incomingSources[next[targets[e]]++] = i;
+		}
+	}
+	// Dense arrays, so the loops below are vectorized by the compiler
+	vector<double> inverseDegrees(n);		// 1 / number of outgoing edges, 0 without outgoing edge
+	vector<double> danglings(n);			// 1 for nodes without outgoing edge, else 0
+	for(size_t i = 0; i < n; i++){
+		uint64_t degree = offsets[i + 1] - offsets[i];
+		inverseDegrees[i] = degree == 0 ? 0 : 1.0 / degree;
+		danglings[i] = degree == 0 ? 1 : 0;
+	}
+	vector<double> contributions(n);		// Rank given through each outgoing edge of each node
+	vector<double> nextRanks(n);
+	size_t blockCount = (n + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	vector<double> blockSums(blockCount);
+	while(iterations < maxIterations){
+		RunBlocks(blockCount, [&](size_t block){
+			size_t first = block * BLOCK_SIZE;
+			size_t last = min(n, first + BLOCK_SIZE);
+			double dangling = 0;
+			for(size_t i = first; i < last; i++){
+				contributions[i] = ranks[i] * inverseDegrees[i];
+				dangling += ranks[i] * danglings[i];
+			}
+			blockSums[block] = dangling;
+		});
+		double dangling = 0;			// Rank of nodes without outgoing edge, given to all nodes
+		for(size_t block = 0; block < blockCount; block++){
+			dangling += blockSums[block];
+		}
+		double base = (1 - damping) / n + damping * dangling / n;	// Rank received by each node without edge
+		RunBlocks(blockCount, [&](size_t block){
+			size_t first = block * BLOCK_SIZE;
+			size_t last = min(n, first + BLOCK_SIZE);
+			double change = 0;
+			for(size_t i = first; i < last; i++){
+				double sum = 0;
+				for(uint64_t k = incomingOffsets[i]; k < incomingOffsets[i + 1]; k++){
+					sum += contributions[incomingSources[k]];
+				}
+				nextRanks[i] = base + damping * sum;
+				change += fabs(nextRanks[i] - ranks[i]);
+			}
+			blockSums[block] = change;
+		});
+		ranks.swap(nextRanks);
+		iterations++;
+		double change = 0;			// Sum of changes of all ranks
+		for(size_t block = 0; block < blockCount; block++){
+			change += blockSums[block];
+		}
+		if(change < tolerance){
+			return true;
+		}
+	}
+	return false;
+}
+
+const vector<double>& PageRank::GetRanks(){return ranks;}
+unsigned PageRank::GetIterations(){return iterations;}
+
+void PageRank::RunBlocks(size_t blockCount, const function<void(size_t)>& compute){
+	unsigned threads = threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+	threads = (unsigned) min((size_t) threads, blockCount);
+	if(threads <= 1){
+		for(size_t block = 0; block < blockCount; block++){
+			compute(block);
+		}
+		return;
+	}
+	vector<thread> workers;
+	for(unsigned t = 0; t < threads; t++){
+		size_t first = blockCount * t / threads;
+		size_t last = blockCount * (t + 1) / threads;
+		workers.push_back(thread([&compute, first, last](){
+			for(size_t block = first; block < last; block++){
+				compute(block);
+			}
+		}));
+	}
+	for(vector<thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker){
+		worker->join();
+	}
+}
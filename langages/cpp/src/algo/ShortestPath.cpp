@@ -0,0 +1,219 @@
+#include "../../include/algo/ShortestPath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+const uint32_t ShortestPath::UNREACHED;
+const uint32_t ShortestPath::NOT_IN_HEAP;
+const uint32_t ShortestPath::SETTLED;
+
+// Margin taken on the heuristic scale, so rounding errors cannot make it overestimate
+static const double HEURISTIC_MARGIN = 1e-9;
+
+ShortestPath::ShortestPath(){
+	arity = 4;
+	euclidean = false;
+	snapshot = NULL;
+	heuristicScale = 0;
+	settledCount = 0;
+}
+
+void ShortestPath::SetArity(unsigned arity){
+	this->arity = max(2u, arity);
+}
+
+void ShortestPath::SetEuclideanWeights(bool euclidean){
+	this->euclidean = euclidean;
+}
+
+void ShortestPath::Prepare(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	const vector<float>& coordinates = snapshot.GetCoordinates();
+	const vector<uint8_t>& fixed = snapshot.GetFixed();
+	this->snapshot = &snapshot;
+	bool allFixed = find(fixed.begin(), fixed.end(), 0) == fixed.end();	// If positions are known for all nodes
+	if(euclidean && !allFixed){
+		cout << "[WARNING] Some nodes have no fixed position ; they are considered at (0,0) to weight their edges" << endl;
+	}
+	weights = euclidean ? vector<float>(snapshot.GetEdgeCount()) : snapshot.GetWeights();
+	// The heuristic is scaled by the lowest weight per unit of length, so it is a lower bound for any edge
+	double scale = numeric_limits<double>::infinity();
+	for(size_t i = 0; i < n; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			double length = hypot((double) coordinates[2 * targets[e]] - coordinates[2 * i], (double) coordinates[2 * targets[e] + 1] - coordinates[2 * i + 1]);
+			if(euclidean){
+				weights[e] = length;
+			}
+			if(length > 0){
+				scale = min(scale, weights[e] / length);
+			}
+		}
+	}
+	heuristicScale = allFixed && scale != numeric_limits<double>::infinity() ? scale * (1 - HEURISTIC_MARGIN) : 0;
+	distances.assign(n, numeric_limits<double>::infinity());
+	parents.assign(n, UNREACHED);
+	heapPositions.assign(n, NOT_IN_HEAP);
+	heap.clear();
+	touched.clear();
+	settledCount = 0;
+}
+
+void ShortestPath::Run(size_t source){
+	Search(source, distances.size(), false);
+}
+
+bool ShortestPath::Run(size_t source, size_t target){
+	// The number of nodes would mean all nodes for Search
+	return Search(source, target < distances.size() ? target : distances.size() + 1, false);
+}
+
+bool ShortestPath::RunAStar(size_t source, size_t target){
+	return Search(source, target < distances.size() ? target : distances.size() + 1, heuristicScale > 0);
+}
+
+const vector<double>& ShortestPath::GetDistances(){return distances;}
+const vector<uint32_t>& ShortestPath::GetParents(){return parents;}
+size_t ShortestPath::GetSettledCount(){return settledCount;}
+
+vector<uint32_t> ShortestPath::GetPath(size_t target){
+	vector<uint32_t> path;
+	if(target >= parents.size() || parents[target] == UNREACHED){
+		return path;
+	}
+	for(uint32_t node = target; ; node = parents[node]){
+		path.push_back(node);
+		if(parents[node] == node){
+			break;
+		}
+	}
+	reverse(path.begin(), path.end());
+	return path;
+}
+
+bool ShortestPath::Search(size_t source, size_t target, bool guided){
+	size_t n = distances.size();
+	Reset();
+	if(snapshot == NULL || source >= n || target > n){
+		cout << "[WARNING] Trying to find a path between nodes which are not in the prepared snapshot ; no node has been reached" << endl;
+		return false;
+	}
+	const vector<uint64_t>& offsets = snapshot->GetOffsets();
+	const vector<uint32_t>& targets = snapshot->GetTargets();
+	distances[source] = 0;
+	parents[source] = source;
+	touched.push_back(source);
+	Push(source, guided ? Heuristic(source, target) : 0);
+	while(!heap.empty()){
+		uint32_t node = Pop();
+		settledCount++;
+		if(node == target){
+			return true;
+		}
+		for(uint64_t e = offsets[node]; e < offsets[node + 1]; e++){
+			uint32_t next = targets[e];
+			double distance = distances[node] + weights[e];
+			if(heapPositions[next] == SETTLED || distance >= distances[next]){
+				continue;
+			}
+			if(parents[next] == UNREACHED){
+				touched.push_back(next);
+			}
+			distances[next] = distance;
+			parents[next] = node;
+			Push(next, guided ? distance + Heuristic(next, target) : distance);
+		}
+	}
+	return target == n;
+}
+
+void ShortestPath::Reset(){
+	for(vector<uint32_t>::iterator node = touched.begin(); node != touched.end(); ++node){
+		distances[*node] = numeric_limits<double>::infinity();
+		parents[*node] = UNREACHED;
+		heapPositions[*node] = NOT_IN_HEAP;
+	}
+	touched.clear();
+	heap.clear();
+	settledCount = 0;
+}
+
+void ShortestPath::Push(uint32_t node, double key){
+	HeapItem item;
+	item.key = key;
+	item.node = node;
+	if(heapPositions[node] == NOT_IN_HEAP){
+		heapPositions[node] = heap.size();
+		heap.push_back(item);
+	}
+	else{
+		heap[heapPositions[node]] = item;
+	}
+	// Keys only decrease : the item can only go up
+	SiftUp(heapPositions[node]);
+}
+
+uint32_t ShortestPath::Pop(){
+	uint32_t node = heap.front().node;
+	heapPositions[node] = SETTLED;
+	heap.front() = heap.back();
+	heap.pop_back();
+	if(!heap.empty()){
+		heapPositions[heap.front().node] = 0;
+		SiftDown(0);
+	}
+	return node;
+}
+
+void ShortestPath::SiftUp(size_t position){
+	HeapItem item = heap[position];
+	// Parents are moved down into the hole until the item fits
+	while(position > 0){
+		size_t parent = (position - 1) / arity;
+		if(heap[parent].key <= item.key){
+			break;
+		}
+		heap[position] = heap[parent];
+		heapPositions[heap[position].node] = position;
+		position = parent;
+	}
+	heap[position] = item;
+	heapPositions[item.node] = position;
+}
+
+void ShortestPath::SiftDown(size_t position){
+	HeapItem item = heap[position];
+	size_t size = heap.size();
+	// The smallest child is moved up into the hole until the item fits
+	while(true){
+		size_t first = position * arity + 1;
+		if(first >= size){
+			break;
+		}
+		size_t last = min(size, first + arity);
+		size_t smallest = first;
+		for(size_t child = first + 1; child < last; child++){
+			if(heap[child].key < heap[smallest].key){
+				smallest = child;
+			}
+		}
+		if(item.key <= heap[smallest].key){
+			break;
+		}
+		heap[position] = heap[smallest];
+		heapPositions[heap[position].node] = position;
+		position = smallest;
+	}
+	heap[position] = item;
+	heapPositions[item.node] = position;
+}
+
+double ShortestPath::Heuristic(uint32_t node, size_t target){
+	const vector<float>& coordinates = snapshot->GetCoordinates();
+	return heuristicScale * hypot((double) coordinates[2 * node] - coordinates[2 * target], (double) coordinates[2 * node + 1] - coordinates[2 * target + 1]);
+}
@@ -0,0 +1,288 @@
+#include "../../include/algo/TimingAnalysis.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <thread>
+
+using namespace std;
+
+const uint64_t TimingAnalysis::NO_EDGE;
+
+// Nodes of a level below which a thread is not worth it
+static const size_t MIN_NODES_PER_THREAD = 4096;
+
+// Node of an empty graph, which has no critical path
+static const uint32_t NO_NODE = 0xFFFFFFFF;
+
+TimingAnalysis::TimingAnalysis(){
+	threadCount = 1;
+	requiredTime = -1;
+	snapshot = NULL;
+	criticalEnd = NO_NODE;
+	endRequiredTime = 0;
+	updatedCount = 0;
+}
+
+void TimingAnalysis::SetThreads(unsigned threadCount){
+	this->threadCount = threadCount;
+}
+
+void TimingAnalysis::SetRequiredTime(double requiredTime){
+	this->requiredTime = requiredTime;
+}
+
+bool TimingAnalysis::Run(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	this->snapshot = NULL;
+	arrivals.clear();
+	required.clear();
+	criticalEdges.clear();
+	criticalEnd = NO_NODE;
+	changedEdges.clear();
+	if(!order.Run(snapshot)){
+		const vector<uint32_t>& cycle = order.GetCycle();
+		cout << "[ERROR] Timing needs a graph without cycle, but \"" << snapshot.GetNodeLabel(cycle.front()) << "\"";
+		for(size_t i = 1; i < cycle.size(); i++){
+			cout << " -> \"" << snapshot.GetNodeLabel(cycle[i]) << "\"";
+		}
+		cout << " -> \"" << snapshot.GetNodeLabel(cycle.front()) << "\" is a cycle ; no time has been computed" << endl;
+		return false;
+	}
+	this->snapshot = &snapshot;
+	positions.resize(n);
+	for(size_t position = 0; position < n; position++){
+		positions[order.GetOrder()[position]] = position;
+	}
+	delays = snapshot.GetWeights();
+	// Incoming edges by counting sort : times are pulled from the previous level, so threads only write their own nodes
+	sources.resize(targets.size());
+	incomingOffsets.assign(n + 1, 0);
+	ends.clear();
+	for(size_t i = 0; i < n; i++){
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			sources[e] = i;
+			incomingOffsets[targets[e] + 1]++;
+		}
+		if(offsets[i] == offsets[i + 1]){
+			ends.push_back(i);
+		}
+	}
+	for(size_t i = 0; i < n; i++){
+		incomingOffsets[i + 1] += incomingOffsets[i];
+	}
+	incomingEdges.resize(targets.size());
+	vector<uint64_t> next(incomingOffsets.begin(), incomingOffsets.end() - 1);
+	for(uint64_t e = 0; e < targets.size(); e++){
+		incomingEdges[next[targets[e]]++] = e;
+	}
+	arrivals.assign(n, 0);
+	required.assign(n, 0);
+	criticalEdges.assign(n, NO_EDGE);
+	queued.assign(n, 0);
+	ComputeAllArrivals();
+	FindCriticalEnd();
+	endRequiredTime = requiredTime < 0 ? GetCriticalDelay() : requiredTime;
+	ComputeAllRequired();
+	updatedCount = n;
+	return true;
+}
+
+void TimingAnalysis::SetDelay(size_t edge, float delay){
+	if(edge >= delays.size()){
+		cout << "[WARNING] Trying to change the delay of edge " << edge << " which is not in the analysed snapshot ; this delay has been ignored" << endl;
+		return;
+	}
+	if(!(delay >= 0)){
+		cout << "[WARNING] A negative or undefined delay has been provided for edge " << edge << " ; its delay has been kept" << endl;
+		return;
+	}
+	delays[edge] = delay;
+	changedEdges.push_back(edge);
+}
+
+void TimingAnalysis::Update(){
+	updatedCount = 0;
+	if(snapshot == NULL){
+		cout << "[WARNING] Trying to update timing which has not been computed ; nothing has been updated" << endl;
+		return;
+	}
+	const vector<uint64_t>& offsets = snapshot->GetOffsets();
+	const vector<uint32_t>& targets = snapshot->GetTargets();
+	const vector<uint32_t>& nodes = order.GetOrder();
+	// Arrival times : nodes after the changed edges, in topological order so each node is computed once
+	priority_queue<uint32_t, vector<uint32_t>, greater<uint32_t> > forward;
+	for(vector<uint64_t>::iterator edge = changedEdges.begin(); edge != changedEdges.end(); ++edge){
+		if(!queued[targets[*edge]]){
+			queued[targets[*edge]] = 1;
+			forward.push(positions[targets[*edge]]);
+		}
+	}
+	while(!forward.empty()){
+		uint32_t node = nodes[forward.top()];
+		forward.pop();
+		queued[node] = 0;
+		updatedCount++;
+		if(!ComputeArrival(node)){
+			continue;
+		}
+		for(uint64_t e = offsets[node]; e < offsets[node + 1]; e++){
+			if(!queued[targets[e]]){
+				queued[targets[e]] = 1;
+				forward.push(positions[targets[e]]);
+			}
+		}
+	}
+	FindCriticalEnd();
+	double endTime = requiredTime < 0 ? GetCriticalDelay() : requiredTime;	// Required time of nodes without outgoing edge
+	if(endTime != endRequiredTime){
+		// All required times depend on the end
+		endRequiredTime = endTime;
+		ComputeAllRequired();
+		updatedCount += nodes.size();
+		changedEdges.clear();
+		return;
+	}
+	// Required times : nodes before the changed edges, in reverse topological order
+	priority_queue<uint32_t> backward;
+	for(vector<uint64_t>::iterator edge = changedEdges.begin(); edge != changedEdges.end(); ++edge){
+		if(!queued[sources[*edge]]){
+			queued[sources[*edge]] = 1;
+			backward.push(positions[sources[*edge]]);
+		}
+	}
+	while(!backward.empty()){
+		uint32_t node = nodes[backward.top()];
+		backward.pop();
+		queued[node] = 0;
+		updatedCount++;
+		if(!ComputeRequired(node)){
+			continue;
+		}
+		for(uint64_t k = incomingOffsets[node]; k < incomingOffsets[node + 1]; k++){
+			uint32_t source = sources[incomingEdges[k]];
+			if(!queued[source]){
+				queued[source] = 1;
+				backward.push(positions[source]);
+			}
+		}
+	}
+	changedEdges.clear();
+}
+
+const vector<double>& TimingAnalysis::GetArrivalTimes(){return arrivals;}
+const vector<double>& TimingAnalysis::GetRequiredTimes(){return required;}
+size_t TimingAnalysis::GetUpdatedCount(){return updatedCount;}
+
+vector<double> TimingAnalysis::GetSlacks(){
+	vector<double> slacks(arrivals.size());
+	for(size_t i = 0; i < slacks.size(); i++){
+		slacks[i] = required[i] - arrivals[i];
+	}
+	return slacks;
+}
+
+double TimingAnalysis::GetCriticalDelay(){
+	return criticalEnd == NO_NODE ? 0 : arrivals[criticalEnd];
+}
+
+vector<uint32_t> TimingAnalysis::GetCriticalPath(){
+	vector<uint32_t> path;
+	if(criticalEnd == NO_NODE){
+		return path;
+	}
+	for(uint32_t node = criticalEnd; ; node = sources[criticalEdges[node]]){
+		path.push_back(node);
+		if(criticalEdges[node] == NO_EDGE){
+			break;
+		}
+	}
+	reverse(path.begin(), path.end());
+	return path;
+}
+
+bool TimingAnalysis::ComputeArrival(uint32_t node){
+	double arrival = 0;				// Latest arrival through incoming edges
+	uint64_t critical = NO_EDGE;			// Edge of the latest arrival
+	for(uint64_t k = incomingOffsets[node]; k < incomingOffsets[node + 1]; k++){
+		uint64_t e = incomingEdges[k];
+		double time = arrivals[sources[e]] + delays[e];
+		if(critical == NO_EDGE || time > arrival){
+			arrival = time;
+			critical = e;
+		}
+	}
+	criticalEdges[node] = critical;
+	if(arrival == arrivals[node]){
+		return false;
+	}
+	arrivals[node] = arrival;
+	return true;
+}
+
+bool TimingAnalysis::ComputeRequired(uint32_t node){
+	const vector<uint64_t>& offsets = snapshot->GetOffsets();
+	const vector<uint32_t>& targets = snapshot->GetTargets();
+	double time = offsets[node] == offsets[node + 1] ? endRequiredTime : numeric_limits<double>::infinity();
+	for(uint64_t e = offsets[node]; e < offsets[node + 1]; e++){
+		time = min(time, required[targets[e]] - delays[e]);
+	}
+	if(time == required[node]){
+		return false;
+	}
+	required[node] = time;
+	return true;
+}
+
+void TimingAnalysis::ComputeAllArrivals(){
+	for(size_t level = 0; level + 1 < order.GetLevelOffsets().size(); level++){
+		ComputeLevel(level, [this](uint32_t node){ComputeArrival(node);});
+	}
+}
+
+void TimingAnalysis::ComputeAllRequired(){
+	for(size_t level = order.GetLevelOffsets().size() - 1; level > 0; level--){
+		ComputeLevel(level - 1, [this](uint32_t node){ComputeRequired(node);});
+	}
+}
+
+void TimingAnalysis::FindCriticalEnd(){
+	criticalEnd = NO_NODE;
+	for(vector<uint32_t>::iterator end = ends.begin(); end != ends.end(); ++end){
+		if(criticalEnd == NO_NODE || arrivals[*end] > arrivals[criticalEnd]){
+			criticalEnd = *end;
+		}
+	}
+}
+
+void TimingAnalysis::ComputeLevel(size_t level, const function<void(uint32_t)>& compute){
+	const vector<uint32_t>& nodes = order.GetOrder();
+	size_t first = order.GetLevelOffsets()[level];
+	size_t last = order.GetLevelOffsets()[level + 1];
+	unsigned threads = threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+	threads = (unsigned) min((size_t) threads, max((size_t) 1, (last - first) / MIN_NODES_PER_THREAD));
+	if(threads <= 1){
+		for(size_t position = first; position < last; position++){
+			compute(nodes[position]);
+		}
+		return;
+	}
+	// Nodes of a level only read times of other levels
+	size_t block = (last - first + threads - 1) / threads;
+	vector<thread> workers;
+	for(unsigned t = 0; t < threads; t++){
+		size_t begin = min(last, first + t * block);
+		size_t end = min(last, begin + block);
+		workers.push_back(thread([&nodes, &compute, begin, end](){
+			for(size_t position = begin; position < end; position++){
+				compute(nodes[position]);
+			}
+		}));
+	}
+	for(vector<thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker){
+		worker->join();
+	}
+}
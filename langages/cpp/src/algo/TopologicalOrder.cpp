@@ -0,0 +1,88 @@
+#include "../../include/algo/TopologicalOrder.h"
+
+#include <algorithm>
+
+using namespace std;
+
+const uint32_t TopologicalOrder::UNORDERED;
+
+TopologicalOrder::TopologicalOrder(){
+	levelOffsets.push_back(0);
+}
+
+bool TopologicalOrder::Run(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	vector<uint32_t> remaining(n, 0);		// Incoming edges of each node from nodes not ordered yet
+	for(vector<uint32_t>::const_iterator target = targets.begin(); target != targets.end(); ++target){
+		remaining[*target]++;
+	}
+	order.clear();
+	order.reserve(n);
+	levels.assign(n, UNORDERED);
+	levelOffsets.assign(1, 0);
+	cycle.clear();
+	for(size_t i = 0; i < n; i++){
+		if(remaining[i] == 0){
+			levels[i] = 0;
+			order.push_back(i);
+		}
+	}
+	// Each level is the list of nodes freed by the previous one, so the order itself is the queue
+	for(uint32_t level = 0; levelOffsets.back() < order.size(); level++){
+		size_t first = levelOffsets.back();
+		size_t last = order.size();
+		levelOffsets.push_back(last);
+		for(size_t position = first; position < last; position++){
+			uint32_t node = order[position];
+			for(uint64_t e = offsets[node]; e < offsets[node + 1]; e++){
+				if(--remaining[targets[e]] == 0){
+					levels[targets[e]] = level + 1;
+					order.push_back(targets[e]);
+				}
+			}
+		}
+	}
+	if(order.size() == n){
+		return true;
+	}
+	FindCycle(snapshot);
+	return false;
+}
+
+const vector<uint32_t>& TopologicalOrder::GetOrder(){return order;}
+const vector<uint32_t>& TopologicalOrder::GetLevels(){return levels;}
+const vector<size_t>& TopologicalOrder::GetLevelOffsets(){return levelOffsets;}
+const vector<uint32_t>& TopologicalOrder::GetCycle(){return cycle;}
+
+void TopologicalOrder::FindCycle(const CsrSnapshot& snapshot){
+	size_t n = snapshot.GetNodeCount();
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	// Each node which cannot be ordered has an incoming edge from another such node : keep one of them
+	vector<uint32_t> predecessors(n, UNORDERED);
+	uint32_t start = UNORDERED;			// First node of the walk
+	for(size_t i = 0; i < n; i++){
+		if(levels[i] != UNORDERED){
+			continue;
+		}
+		start = min(start, (uint32_t) i);
+		for(uint64_t e = offsets[i]; e < offsets[i + 1]; e++){
+			if(levels[targets[e]] == UNORDERED){
+				predecessors[targets[e]] = i;
+			}
+		}
+	}
+	// Going back from predecessor to predecessor always ends in a loop
+	vector<uint32_t> steps(n, UNORDERED);		// Position of each node in the walk
+	vector<uint32_t> walk;
+	uint32_t node = start;
+	while(steps[node] == UNORDERED){
+		steps[node] = walk.size();
+		walk.push_back(node);
+		node = predecessors[node];
+	}
+	cycle.assign(walk.begin() + steps[node], walk.end());
+	reverse(cycle.begin(), cycle.end());
+}
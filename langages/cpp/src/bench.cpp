@@ -0,0 +1,164 @@
+#include "../include/model/Graph.h"
+#include "../include/algo/BreadthFirstSearch.h"
+#include "../include/algo/GraphGenerator.h"
+#include "../include/algo/NodeOrder.h"
+#include "../include/algo/PageRank.h"
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <math.h>
+#include <thread>
+
+using namespace std;
+
+string ForgePath(filesystem::path path, string filename, string extension){
+	return (path / filename).string() + "." + extension;
+}
+
+double SecondsSince(chrono::steady_clock::time_point start){
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void PrintResult(string name, double seconds, size_t bytes){
+	cout << name << " : " << seconds << " s";
+	if(bytes > 0){
+		cout << " (" << bytes / seconds / 1e6 << " MB/s)";
+	}
+	cout << endl;
+}
+
+// Deterministic pseudo-random graph with fixed positions, so results can be compared between runs
+void BuildRandomGraph(Graph& graph, size_t nodeCount, size_t edgeCount){
+	vector<Node*> nodes;
+	nodes.reserve(nodeCount);
+	uint64_t state = 42;
+	for(size_t i = 0; i < nodeCount; i++){
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		nodes.push_back(graph.CreateNode("N" + to_string(i), (state >> 40) % 10000, (state >> 20) % 10000));
+	}
+	for(size_t i = 0; i < edgeCount; i++){
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		graph.ConnectNodes(nodes[i % nodeCount], nodes[(state >> 33) % nodeCount], false, "E" + to_string(i % 100));
+	}
+}
+
+// Grid whose nodes are numbered in a pseudo-random order, as a graph read from a file may be : neighbours are far apart in the list of nodes
+void BuildShuffledGrid(Graph& graph, size_t nodeCount){
+	size_t side = max((size_t) 1, (size_t) sqrt((double) nodeCount));
+	GraphGenerator generator;
+	generator.SetSeed(42);
+	generator.SetShuffle(true);
+	graph.Thaw(generator.Grid(side, side));
+}
+
+// Time each generator and the bulk copy of its snapshot into a graph
+void BenchGenerators(size_t edgeCount){
+	GraphGenerator generator;
+	generator.SetSeed(42);
+	size_t nodeCount = max((size_t) 1, edgeCount / 8);
+	size_t side = max((size_t) 1, (size_t) sqrt((double) edgeCount / 4));
+	unsigned scale = 1;
+	while(((size_t) 1 << scale) < nodeCount){
+		scale++;
+	}
+	// Random geometric graphs get about 8 neighbours per node
+	float radius = 1000 * sqrt(8 / (M_PI * nodeCount));
+	vector<pair<string, function<CsrSnapshot()> > > generators = {
+		{"ErdosRenyi", [&](){return generator.ErdosRenyi(nodeCount, edgeCount);}},
+		{"Rmat", [&](){return generator.Rmat(scale, edgeCount);}},
+		{"Grid", [&](){return generator.Grid(side, side);}},
+		{"RandomGeometric", [&](){return generator.RandomGeometric(nodeCount, radius);}},
+		{"PowerLaw", [&](){return generator.PowerLaw(nodeCount, 8);}}
+	};
+	for(vector<pair<string, function<CsrSnapshot()> > >::iterator generate = generators.begin(); generate != generators.end(); ++generate){
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		CsrSnapshot snapshot = generate->second();
+		PrintResult(generate->first + " (" + to_string(snapshot.GetEdgeCount()) + " edges)", SecondsSince(start), 0);
+		Graph graph;
+		start = chrono::steady_clock::now();
+		graph.Thaw(snapshot);
+		PrintResult("Thaw " + generate->first, SecondsSince(start), 0);
+	}
+}
+
+// Time the import of a generated power-law graph written as GraphML
+void BenchImportGraphml(filesystem::path path, size_t edgeCount){
+	string pathGraphml = ForgePath(path, "bench", "graphml");
+	GraphGenerator generator;
+	generator.SetSeed(42);
+	{
+		Graph generated;
+		generated.Thaw(generator.PowerLaw(max((size_t) 1, edgeCount / 8), 8));
+		generated.ExportGraphml(pathGraphml);
+	}
+	Graph graph;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	graph.ImportGraphml(pathGraphml);
+	PrintResult("ImportGraphml", SecondsSince(start), filesystem::file_size(pathGraphml));
+	filesystem::remove(pathGraphml);
+}
+
+// Time a breadth-first search from each of a few nodes and some PageRank iterations on a snapshot of the graph in its current order
+void BenchTraversals(Graph& graph, string orderName){
+	CsrSnapshot snapshot = graph.Freeze();
+	BreadthFirstSearch search;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for(size_t source = 0; source < 8; source++){
+		search.Run(snapshot, source * snapshot.GetNodeCount() / 8);
+	}
+	PrintResult("8 BreadthFirstSearch (" + orderName + " order)", SecondsSince(start), 0);
+	PageRank pageRank;
+	pageRank.SetTolerance(0);
+	pageRank.SetMaxIterations(20);
+	start = chrono::steady_clock::now();
+	pageRank.Run(snapshot);
+	PrintResult("20 PageRank iterations (" + orderName + " order)", SecondsSince(start), 0);
+	cout << "Average gap between ends of edges (" << orderName << " order) : " << NodeOrder::ComputeAverageGap(snapshot, vector<uint32_t>()) << endl;
+}
+
+// Each order starts again from the creation order : a degree sort keeps the order of equal degrees, so it would inherit the previous order
+void BenchReorder(size_t nodeCount){
+	Graph shuffled;
+	BuildShuffledGrid(shuffled, nodeCount);
+	BenchTraversals(shuffled, "creation");
+	NodeOrder::Method methods[] = {NodeOrder::REVERSE_CUTHILL_MCKEE, NodeOrder::BREADTH_FIRST, NodeOrder::DEGREE, NodeOrder::HILBERT};
+	string names[] = {"reverse Cuthill-McKee", "breadth-first", "degree", "Hilbert"};
+	for(size_t i = 0; i < 4; i++){
+		Graph grid;
+		BuildShuffledGrid(grid, nodeCount);
+		NodeOrder order;
+		order.SetMethod(methods[i]);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		grid.Reorder(order);
+		PrintResult("Reorder (" + names[i] + ")", SecondsSince(start), 0);
+		BenchTraversals(grid, names[i]);
+	}
+}
+
+void BenchExportDot(Graph& graph, filesystem::path path, unsigned threadCount){
+	string pathDot = ForgePath(path, "bench", "dot");
+	graph.SetExportThreads(threadCount);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	graph.ExportDot(pathDot, 0.02);
+	PrintResult("ExportDot (" + to_string(threadCount) + " threads)", SecondsSince(start), filesystem::file_size(pathDot));
+	filesystem::remove(pathDot);
+	graph.SetExportThreads(1);
+}
+
+int main(int argc, char* argv[]){
+	size_t edgeCount = argc > 1 ? atoll(argv[1]) : 1000000;
+	filesystem::path pathOut = argc > 2 ? filesystem::path(argv[2]) : filesystem::temp_directory_path();
+
+	Graph graph;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	BuildRandomGraph(graph, max((size_t) 1, edgeCount / 8), edgeCount);
+	PrintResult("Build " + to_string(edgeCount) + " edges", SecondsSince(start), 0);
+	BenchExportDot(graph, pathOut, 1);
+	BenchExportDot(graph, pathOut, max(2u, thread::hardware_concurrency()));
+
+	BenchGenerators(edgeCount);
+	BenchImportGraphml(pathOut, edgeCount);
+	BenchReorder(max((size_t) 1, edgeCount / 4));
+	return 0;
+}
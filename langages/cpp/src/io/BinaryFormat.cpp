@@ -0,0 +1,248 @@
+#include "../../include/io/BinaryFormat.h"
+#include "../../include/io/MappedFile.h"
+#include "../../include/model/Graph.h"
+
+#include <string.h>
+
+using namespace std;
+
+const uint32_t BinaryFormat::VERSION;
+
+// Sections of the format
+static const uint32_t TAG_OFFSETS = 0x5346464F;		// "OFFS" : uint64[nodes+1], first outgoing edge of each node
+static const uint32_t TAG_TARGETS = 0x54475254;		// "TRGT" : uint32[edges], target node of each edge
+static const uint32_t TAG_NODE_LABELS = 0x4C424C4E;	// "NLBL" : uint64[nodes+1], position of each node label in the pool
+static const uint32_t TAG_EDGE_LABELS = 0x4C424C45;	// "ELBL" : uint64[edges+1], position of each edge label in the pool
+static const uint32_t TAG_POOL = 0x4C4F4F50;		// "POOL" : char[], all labels
+static const uint32_t TAG_COORDINATES = 0x524F4F43;	// "COOR" : float32[2*nodes], X-position and Y-position of each node
+static const uint32_t TAG_FIXED = 0x44584946;		// "FIXD" : uint8[nodes], 1 if the position of the node is fixed
+static const uint32_t TAG_WEIGHTS = 0x54484757;		// "WGHT" : float32[edges], weight of each edge (optional, 1 if missing)
+
+static const char MAGIC[8] = {'L', 'I', 'E', 'G', 'E', 'B', 'I', 'N'};
+static const size_t HEADER_SIZE = 32;
+static const size_t SECTION_ENTRY_SIZE = 24;
+
+static bool IsLittleEndian(){
+	uint16_t one = 1;
+	return *((uint8_t*) &one) == 1;
+}
+
+// Append a value to a buffer in little-endian order
+template<typename T> static void PutLe(string& buffer, T value){
+	char bytes[sizeof(T)];
+	memcpy(bytes, &value, sizeof(T));
+	if(!IsLittleEndian()){
+		reverse(bytes, bytes + sizeof(T));
+	}
+	buffer.append(bytes, sizeof(T));
+}
+
+// Read the i-th little-endian value of an array (memcpy is turned into a simple load by the compiler)
+template<typename T> static T GetLe(const char* data, size_t i){
+	T value;
+	if(IsLittleEndian()){
+		memcpy(&value, data + i * sizeof(T), sizeof(T));
+		return value;
+	}
+	char bytes[sizeof(T)];
+	memcpy(bytes, data + i * sizeof(T), sizeof(T));
+	reverse(bytes, bytes + sizeof(T));
+	memcpy(&value, bytes, sizeof(T));
+	return value;
+}
+
+// Copy a mapped little-endian array, without conversion on little-endian hosts
+template<typename T> static void GetArray(const char* data, size_t count, vector<T>& values){
+	values.resize(count);
+	if(count == 0){
+		return;
+	}
+	if(IsLittleEndian()){
+		memcpy(values.data(), data, count * sizeof(T));
+		return;
+	}
+	for(size_t i = 0; i < count; i++){
+		values[i] = GetLe<T>(data, i);
+	}
+}
+
+// Append an array to a section, without conversion on little-endian hosts
+template<typename T> static void PutArray(string& section, const vector<T>& values){
+	if(IsLittleEndian()){
+		section.append((const char*) values.data(), values.size() * sizeof(T));
+		return;
+	}
+	section.reserve(section.size() + values.size() * sizeof(T));
+	for(typename vector<T>::const_iterator value = values.begin(); value != values.end(); ++value){
+		PutLe(section, *value);
+	}
+}
+
+bool BinaryFormat::Save(const CsrSnapshot& snapshot, string path){
+	// Sections to write, in order
+	vector<pair<uint32_t, string> > sections(8);
+	sections[0].first = TAG_OFFSETS;
+	PutArray(sections[0].second, snapshot.GetOffsets());
+	sections[1].first = TAG_TARGETS;
+	PutArray(sections[1].second, snapshot.GetTargets());
+	sections[2].first = TAG_NODE_LABELS;
+	PutArray(sections[2].second, snapshot.GetNodeLabelOffsets());
+	sections[3].first = TAG_EDGE_LABELS;
+	PutArray(sections[3].second, snapshot.GetEdgeLabelOffsets());
+	sections[4].first = TAG_POOL;
+	sections[4].second = snapshot.GetLabelPool();
+	sections[5].first = TAG_COORDINATES;
+	PutArray(sections[5].second, snapshot.GetCoordinates());
+	sections[6].first = TAG_FIXED;
+	PutArray(sections[6].second, snapshot.GetFixed());
+	sections[7].first = TAG_WEIGHTS;
+	PutArray(sections[7].second, snapshot.GetWeights());
+	// Header
+	string header(MAGIC, sizeof(MAGIC));
+	PutLe<uint32_t>(header, VERSION);
+	PutLe<uint32_t>(header, sections.size());
+	PutLe<uint64_t>(header, snapshot.GetNodeCount());
+	PutLe<uint64_t>(header, snapshot.GetEdgeCount());
+	// Table of sections : payloads start after the table, each one aligned on 8 bytes
+	uint64_t offset = HEADER_SIZE + sections.size() * SECTION_ENTRY_SIZE;
+	for(vector<pair<uint32_t, string> >::iterator section = sections.begin(); section != sections.end(); ++section){
+		offset = (offset + 7) & ~((uint64_t) 7);
+		PutLe<uint32_t>(header, section->first);
+		PutLe<uint32_t>(header, 0);
+		PutLe<uint64_t>(header, offset);
+		PutLe<uint64_t>(header, section->second.size());
+		offset += section->second.size();
+	}
+	ofstream file(path, ios::binary | ios::trunc);
+	if(!file){
+		cout << "[ERROR] Failed to open binary file \"" << path << "\" ; the graph has not been saved" << endl;
+		return false;
+	}
+	file.write(header.data(), header.size());
+	size_t written = header.size();
+	for(vector<pair<uint32_t, string> >::iterator section = sections.begin(); section != sections.end(); ++section){
+		static const char padding[8] = {0};
+		file.write(padding, ((written + 7) & ~((size_t) 7)) - written);
+		written = (written + 7) & ~((size_t) 7);
+		file.write(section->second.data(), section->second.size());
+		written += section->second.size();
+	}
+	file.close();
+	if(!file){
+		cout << "[ERROR] Failed to write binary file \"" << path << "\" ; the saved graph is incomplete" << endl;
+		return false;
+	}
+	return true;
+}
+
+bool BinaryFormat::Load(string path, Graph& graph){
+	MappedFile file;
+	if(!file.Open(path)){
+		cout << "[ERROR] Failed to open binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+		return false;
+	}
+	const char* data = file.GetData();
+	size_t size = file.GetSize();
+	if(size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0){
+		cout << "[ERROR] File \"" << path << "\" is not a LIEGE binary file ; no node and edge as been imported" << endl;
+		return false;
+	}
+	uint32_t version = GetLe<uint32_t>(data + 8, 0);
+	uint32_t sectionCount = GetLe<uint32_t>(data + 12, 0);
+	uint64_t nodeCount = GetLe<uint64_t>(data + 16, 0);
+	uint64_t edgeCount = GetLe<uint64_t>(data + 24, 0);
+	if(version > VERSION){
+		cout << "[ERROR] Binary file \"" << path << "\" has version " << version << " but only version " << VERSION << " and older are supported ; no node and edge as been imported" << endl;
+		return false;
+	}
+	if(sectionCount > (size - HEADER_SIZE) / SECTION_ENTRY_SIZE || nodeCount > 0xFFFFFFFFull || edgeCount > size){
+		cout << "[ERROR] Corrupted header in binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+		return false;
+	}
+	// Locate known sections, ignore unknown ones
+	const char* offsets = NULL;
+	const char* targets = NULL;
+	const char* nodeLabels = NULL;
+	const char* edgeLabels = NULL;
+	const char* pool = NULL;
+	const char* coordinates = NULL;
+	const char* fixed = NULL;
+	const char* weights = NULL;
+	uint64_t poolSize = 0;
+	for(uint32_t i = 0; i < sectionCount; i++){
+		const char* entry = data + HEADER_SIZE + i * SECTION_ENTRY_SIZE;
+		uint32_t tag = GetLe<uint32_t>(entry, 0);
+		uint64_t offset = GetLe<uint64_t>(entry + 8, 0);
+		uint64_t length = GetLe<uint64_t>(entry + 16, 0);
+		if(offset > size || length > size - offset){
+			cout << "[ERROR] Section " << i << " is out of binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+			return false;
+		}
+		// Every array section must have exactly the expected size
+		uint64_t expected = length;
+		const char** target = NULL;
+		switch(tag){
+			case TAG_OFFSETS : target = &offsets; expected = (nodeCount + 1) * 8; break;
+			case TAG_TARGETS : target = &targets; expected = edgeCount * 4; break;
+			case TAG_NODE_LABELS : target = &nodeLabels; expected = (nodeCount + 1) * 8; break;
+			case TAG_EDGE_LABELS : target = &edgeLabels; expected = (edgeCount + 1) * 8; break;
+			case TAG_POOL : target = &pool; poolSize = length; break;
+			case TAG_COORDINATES : target = &coordinates; expected = nodeCount * 8; break;
+			case TAG_FIXED : target = &fixed; expected = nodeCount; break;
+			case TAG_WEIGHTS : target = &weights; expected = edgeCount * 4; break;
+			default : continue;
+		}
+		if(length != expected){
+			cout << "[ERROR] Section " << i << " of binary file \"" << path << "\" has a wrong size ; no node and edge as been imported" << endl;
+			return false;
+		}
+		*target = data + offset;
+	}
+	if(offsets == NULL || targets == NULL || nodeLabels == NULL || edgeLabels == NULL || pool == NULL || coordinates == NULL || fixed == NULL){
+		cout << "[ERROR] Missing section in binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+		return false;
+	}
+	// Copy the mapped sections into a snapshot, whose indexes are checked before creating anything, so a corrupted file cannot add half a graph
+	CsrSnapshot snapshot;
+	GetArray(offsets, nodeCount + 1, snapshot.offsets);
+	GetArray(targets, edgeCount, snapshot.targets);
+	GetArray(nodeLabels, nodeCount + 1, snapshot.nodeLabelOffsets);
+	GetArray(edgeLabels, edgeCount + 1, snapshot.edgeLabelOffsets);
+	snapshot.labelPool.assign(pool, poolSize);
+	GetArray(coordinates, 2 * nodeCount, snapshot.coordinates);
+	GetArray(fixed, nodeCount, snapshot.fixed);
+	// Files written before weights have no weight section
+	if(weights != NULL){
+		GetArray(weights, edgeCount, snapshot.weights);
+	}
+	else{
+		snapshot.weights.assign(edgeCount, 1);
+	}
+	if(snapshot.offsets[0] != 0 || snapshot.offsets[nodeCount] != edgeCount || snapshot.nodeLabelOffsets[0] != 0 || snapshot.edgeLabelOffsets[edgeCount] > poolSize){
+		cout << "[ERROR] Corrupted offsets in binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+		return false;
+	}
+	for(uint64_t i = 0; i < nodeCount; i++){
+		if(snapshot.offsets[i] > snapshot.offsets[i + 1] || snapshot.nodeLabelOffsets[i] > snapshot.nodeLabelOffsets[i + 1]){
+			cout << "[ERROR] Corrupted offsets for node " << i << " in binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+			return false;
+		}
+	}
+	if(snapshot.nodeLabelOffsets[nodeCount] > snapshot.edgeLabelOffsets[0]){
+		cout << "[ERROR] Corrupted label offsets in binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+		return false;
+	}
+	for(uint64_t i = 0; i < edgeCount; i++){
+		if(snapshot.targets[i] >= nodeCount || snapshot.edgeLabelOffsets[i] > snapshot.edgeLabelOffsets[i + 1]){
+			cout << "[ERROR] Corrupted edge " << i << " in binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+			return false;
+		}
+		if(!(snapshot.weights[i] >= 0)){
+			cout << "[ERROR] Corrupted weight of edge " << i << " in binary file \"" << path << "\" ; no node and edge as been imported" << endl;
+			return false;
+		}
+	}
+	// Nodes and edges are created in bulk
+	graph.Thaw(snapshot);
+	return true;
+}
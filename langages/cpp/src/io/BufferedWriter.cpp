@@ -0,0 +1,139 @@
+#include "../../include/io/BufferedWriter.h"
+
+#include <charconv>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace std;
+
+const size_t BufferedWriter::BUFFER_SIZE;
+
+BufferedWriter::BufferedWriter(){
+	used = 0;
+	fd = -1;
+	ownsFd = false;
+	failed = false;
+}
+
+BufferedWriter::~BufferedWriter(){
+	Close();
+}
+
+bool BufferedWriter::Open(string path){
+	Close();
+	int newFd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(newFd < 0){
+		return false;
+	}
+	Attach(newFd);
+	ownsFd = true;
+	return true;
+}
+
+void BufferedWriter::Attach(int fd){
+	Close();
+	this->fd = fd;
+	ownsFd = false;
+	failed = false;
+	buffer.resize(BUFFER_SIZE);
+}
+
+bool BufferedWriter::Close(){
+	if(fd < 0){
+		return !failed;
+	}
+	Flush();
+	if(ownsFd && close(fd) != 0){
+		failed = true;
+	}
+	fd = -1;
+	ownsFd = false;
+	return !failed;
+}
+
+bool BufferedWriter::Flush(){
+	if(fd < 0){
+		return !failed;
+	}
+	WriteAll(buffer.data(), used);
+	used = 0;
+	return !failed;
+}
+
+void BufferedWriter::WriteAll(const char* data, size_t size){
+	// A single write can be partial or interrupted by a signal
+	for(size_t written = 0; written < size && !failed;){
+		ssize_t result = write(fd, data + written, size - written);
+		if(result < 0 && errno == EINTR){
+			continue;
+		}
+		if(result <= 0){
+			failed = true;
+			break;
+		}
+		written += result;
+	}
+}
+
+char* BufferedWriter::Reserve(size_t count){
+	if(used + count > buffer.size()){
+		if(fd >= 0){
+			Flush();
+		}
+		if(used + count > buffer.size()){
+			buffer.resize(max(2 * buffer.size(), max(used + count, BUFFER_SIZE)));
+		}
+	}
+	char* position = buffer.data() + used;
+	used += count;
+	return position;
+}
+
+void BufferedWriter::Write(string_view text){
+	// An empty text may have no data at all, which memcpy does not accept
+	if(text.empty()){
+		return;
+	}
+	// Large blocks go directly to the file instead of being copied in the buffer
+	if(fd >= 0 && text.size() >= BUFFER_SIZE){
+		Flush();
+		WriteAll(text.data(), text.size());
+		return;
+	}
+	memcpy(Reserve(text.size()), text.data(), text.size());
+}
+
+void BufferedWriter::Write(char c){
+	*Reserve(1) = c;
+}
+
+void BufferedWriter::WriteInt(long long value){
+	char text[24];
+	to_chars_result result = to_chars(text, text + sizeof(text), value);
+	Write(string_view(text, result.ptr - text));
+}
+
+void BufferedWriter::WriteFloat(float value){
+	// General format with 6 significant digits is what std::ostream prints by default
+	char text[32];
+	to_chars_result result = to_chars(text, text + sizeof(text), value, chars_format::general, 6);
+	Write(string_view(text, result.ptr - text));
+}
+
+void BufferedWriter::WriteFloatExact(float value){
+	char text[32];
+	to_chars_result result = to_chars(text, text + sizeof(text), value);
+	Write(string_view(text, result.ptr - text));
+}
+
+const char* BufferedWriter::GetData(){return buffer.data();}
+size_t BufferedWriter::GetSize(){return used;}
+void BufferedWriter::Reset(){used = 0;}
+bool BufferedWriter::IsFailed(){return failed;}
+
+void BufferedWriter::Release(){
+	used = 0;
+	vector<char>().swap(buffer);
+}
@@ -0,0 +1,472 @@
+#include "../../include/io/DotFormat.h"
+#include "../../include/io/MappedFile.h"
+#include "../../include/model/Graph.h"
+
+#include <string.h>
+#include <unordered_map>
+
+using namespace std;
+
+// Kinds of DOT tokens
+enum TokenType{
+	TOKEN_END,		// End of file
+	TOKEN_ID,		// Identifier, number, quoted string or HTML string
+	TOKEN_EDGE_OP,		// -> or --
+	TOKEN_PUNCT,		// One of { } [ ] = ; , :
+	TOKEN_ERROR		// Unterminated string or comment, unknown character
+};
+
+// Tokenizer reading the mapped file in place
+class DotLexer{
+
+public:
+
+	DotLexer(const char* data, size_t size) : begin(data), current(data), end(data + size), line(1){}
+
+	// Read the next token. The text of identifiers is unescaped into the given buffer, which is reused from one token to another.
+	TokenType Next(string& text){
+		SkipBlanks();
+		text.clear();
+		if(current >= end){
+			return TOKEN_END;
+		}
+		char c = *current;
+		// Quoted string : only \", \\ and line continuations are unescaped, other escapes (\n, \l, \N ...) are kept as they are
+		if(c == '"'){
+			for(current++; current < end && *current != '"'; current++){
+				if(*current == '\\' && current + 1 < end){
+					if(current[1] == '"' || current[1] == '\\'){
+						text += current[1];
+						current++;
+						continue;
+					}
+					if(current[1] == '\n' || current[1] == '\r'){
+						current += (current[1] == '\r' && current + 2 < end && current[2] == '\n') ? 2 : 1;
+						line++;
+						continue;
+					}
+				}
+				if(*current == '\n'){
+					line++;
+				}
+				text += *current;
+			}
+			if(current >= end){
+				return TOKEN_ERROR;
+			}
+			current++;
+			return TOKEN_ID;
+		}
+		// HTML string : keep everything between the outermost brackets
+		if(c == '<'){
+			int depth = 0;
+			const char* begin = current;
+			for(; current < end; current++){
+				if(*current == '<'){
+					depth++;
+				}
+				else if(*current == '>' && --depth == 0){
+					break;
+				}
+				else if(*current == '\n'){
+					line++;
+				}
+			}
+			if(current >= end){
+				return TOKEN_ERROR;
+			}
+			text.assign(begin + 1, current - begin - 1);
+			current++;
+			return TOKEN_ID;
+		}
+		if(c == '-' && current + 1 < end && (current[1] == '>' || current[1] == '-')){
+			text.assign(current, 2);
+			current += 2;
+			return TOKEN_EDGE_OP;
+		}
+		if(strchr("{}[]=;,:", c) != NULL){
+			text.assign(1, c);
+			current++;
+			return TOKEN_PUNCT;
+		}
+		// Unquoted identifier or numeral
+		const char* begin = current;
+		while(current < end && (isalnum((unsigned char) *current) || *current == '_' || *current == '.' || (*current & 0x80) || (*current == '-' && current == begin))){
+			current++;
+		}
+		if(current == begin){
+			return TOKEN_ERROR;
+		}
+		text.assign(begin, current - begin);
+		return TOKEN_ID;
+	}
+
+	int GetLine(){return line;}
+
+private:
+
+	// Skip spaces, comments and preprocessor lines
+	void SkipBlanks(){
+		while(current < end){
+			char c = *current;
+			if(c == '\n'){
+				line++;
+				current++;
+			}
+			else if(c == ' ' || c == '\t' || c == '\r'){
+				current++;
+			}
+			else if(c == '#' && (current == begin || current[-1] == '\n')){
+				while(current < end && *current != '\n'){
+					current++;
+				}
+			}
+			else if(c == '/' && current + 1 < end && current[1] == '/'){
+				while(current < end && *current != '\n'){
+					current++;
+				}
+			}
+			else if(c == '/' && current + 1 < end && current[1] == '*'){
+				for(current += 2; current < end && !(*current == '*' && current + 1 < end && current[1] == '/'); current++){
+					if(*current == '\n'){
+						line++;
+					}
+				}
+				current = min(current + 2, end);
+			}
+			else{
+				return;
+			}
+		}
+	}
+
+	const char* begin;
+	const char* current;
+	const char* end;
+	int line;
+
+};
+
+// Attributes read by the importer, for a statement or as default values
+struct DotAttributes{
+	bool hasLabel = false;
+	string label;
+	bool hasPos = false;
+	string pos;
+	bool hasDir = false;
+	string dir;
+
+	// Override these attributes by the ones given in another set
+	void Merge(const DotAttributes& other){
+		if(other.hasLabel){hasLabel = true; label = other.label;}
+		if(other.hasPos){hasPos = true; pos = other.pos;}
+		if(other.hasDir){hasDir = true; dir = other.dir;}
+	}
+};
+
+// Default attributes of a scope (graph or subgraph)
+struct DotScope{
+	DotAttributes node;
+	DotAttributes edge;
+};
+
+// One-pass reader : statements are executed as soon as they are read
+class DotReader{
+
+public:
+
+	DotReader(const char* data, size_t size, float scale, Graph& graph, string path) : lexer(data, size), scale(scale), graph(graph), path(path){}
+
+	bool Read(){
+		// Header : [strict] (graph | digraph) [ID] {
+		Advance();
+		if(type == TOKEN_ID && Is("strict")){
+			Advance();
+		}
+		if(type != TOKEN_ID || !(Is("graph") || Is("digraph"))){
+			return Error("\"graph\" or \"digraph\" expected");
+		}
+		directed = Is("digraph");
+		Advance();
+		if(type == TOKEN_ID){
+			Advance();
+		}
+		if(!IsPunct('{')){
+			return Error("\"{\" expected");
+		}
+		Advance();
+		scopes.push_back(DotScope());
+		// Statements until the closing brace of the graph
+		while(!scopes.empty()){
+			if(type == TOKEN_END){
+				return Error("unexpected end of file, \"}\" expected");
+			}
+			if(!ReadStatement()){
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+
+	bool ReadStatement(){
+		if(IsPunct(';') || IsPunct(',')){
+			Advance();
+			return true;
+		}
+		if(IsPunct('}')){
+			scopes.pop_back();
+			Advance();
+			return true;
+		}
+		// Subgraph : its content is flattened, with its own default attributes
+		if(IsPunct('{') || (type == TOKEN_ID && Is("subgraph"))){
+			if(!IsPunct('{')){
+				Advance();
+				if(type == TOKEN_ID){
+					Advance();
+				}
+				if(!IsPunct('{')){
+					return Error("\"{\" expected after subgraph");
+				}
+			}
+			scopes.push_back(scopes.back());
+			Advance();
+			if(type == TOKEN_EDGE_OP){
+				return Error("subgraphs in edge statements are not supported");
+			}
+			return true;
+		}
+		if(type != TOKEN_ID){
+			return Error("statement expected");
+		}
+		// Default attributes
+		if(Is("graph") || Is("node") || Is("edge")){
+			string kind = token;
+			Advance();
+			if(IsPunct('=')){
+				// "graph = ..." is a graph attribute named like a keyword
+				return SkipGraphAttribute();
+			}
+			DotAttributes attributes;
+			if(!ReadAttributes(attributes)){
+				return false;
+			}
+			if(kind == "node"){
+				scopes.back().node.Merge(attributes);
+			}
+			else if(kind == "edge"){
+				scopes.back().edge.Merge(attributes);
+			}
+			return true;
+		}
+		// Node statement, edge statement or graph attribute
+		ids.clear();
+		ids.push_back(token);
+		Advance();
+		if(IsPunct('=')){
+			return SkipGraphAttribute();
+		}
+		if(!SkipPort()){
+			return false;
+		}
+		while(type == TOKEN_EDGE_OP){
+			Advance();
+			if(type != TOKEN_ID){
+				return Error(IsPunct('{') ? "subgraphs in edge statements are not supported" : "node identifier expected after edge operator");
+			}
+			ids.push_back(token);
+			Advance();
+			if(!SkipPort()){
+				return false;
+			}
+		}
+		DotAttributes attributes;
+		if(!ReadAttributes(attributes)){
+			return false;
+		}
+		if(ids.size() == 1){
+			DeclareNode(ids[0], attributes);
+			return true;
+		}
+		// Edge chain : a -> b -> c creates a -> b and b -> c
+		DotAttributes edgeAttributes = scopes.back().edge;
+		edgeAttributes.Merge(attributes);
+		for(size_t i = 0; i + 1 < ids.size(); i++){
+			Connect(GetNode(ids[i]), GetNode(ids[i + 1]), edgeAttributes);
+		}
+		return true;
+	}
+
+	// Create a node or update it if it has already been used by an edge
+	void DeclareNode(const string& id, const DotAttributes& attributes){
+		Node* node = GetNode(id);
+		if(attributes.hasLabel){
+			node->SetName(Label(attributes.label, id));
+		}
+		if(attributes.hasPos){
+			SetPos(node, attributes.pos);
+		}
+	}
+
+	// Find a node by its identifier, create it with default attributes if it is new
+	Node* GetNode(const string& id){
+		unordered_map<string, Node*>::iterator found = idToNode.find(id);
+		if(found != idToNode.end()){
+			return found->second;
+		}
+		const DotAttributes& defaults = scopes.back().node;
+		Node* node = graph.CreateNode(defaults.hasLabel ? Label(defaults.label, id) : id);
+		if(defaults.hasPos){
+			SetPos(node, defaults.pos);
+		}
+		idToNode[id] = node;
+		return node;
+	}
+
+	void Connect(Node* fromNode, Node* toNode, const DotAttributes& attributes){
+		string label = attributes.hasLabel ? attributes.label : "";
+		// Undirected graphs and edges with arrows on both sides (or none) are bidirectional, like in ImportGraphml
+		if(!directed || (attributes.hasDir && (attributes.dir == "both" || attributes.dir == "none"))){
+			graph.ConnectNodes(fromNode, toNode, true, label);
+		}
+		else if(attributes.hasDir && attributes.dir == "back"){
+			graph.ConnectNodes(toNode, fromNode, false, label);
+		}
+		else{
+			graph.ConnectNodes(fromNode, toNode, false, label);
+		}
+	}
+
+	// "\N" in a label is replaced by the identifier of the node
+	static string Label(const string& label, const string& id){
+		if(label.find("\\N") == string::npos){
+			return label;
+		}
+		string result;
+		for(size_t i = 0; i < label.size(); i++){
+			if(label[i] == '\\' && i + 1 < label.size() && label[i + 1] == 'N'){
+				result += id;
+				i++;
+			}
+			else{
+				result += label[i];
+			}
+		}
+		return result;
+	}
+
+	// "x,y" or "x,y!" : inverse of the transformation done by Node::ToDot
+	void SetPos(Node* node, const string& pos){
+		if(scale <= 0){
+			return;
+		}
+		char* next = NULL;
+		float x = strtof(pos.c_str(), &next);
+		if(next == pos.c_str() || *next != ','){
+			cout << "[WARNING] Failed to read pos \"" << pos << "\" of node \"" << node->GetName() << "\" from DOT file \"" << path << "\" ; this position has been ignored" << endl;
+			return;
+		}
+		const char* yText = next + 1;
+		float y = strtof(yText, &next);
+		if(next == yText){
+			cout << "[WARNING] Failed to read pos \"" << pos << "\" of node \"" << node->GetName() << "\" from DOT file \"" << path << "\" ; this position has been ignored" << endl;
+			return;
+		}
+		node->SetPos(x / scale, -y / scale);
+	}
+
+	// [a=b, c=d][e=f] ...
+	bool ReadAttributes(DotAttributes& attributes){
+		while(IsPunct('[')){
+			Advance();
+			while(!IsPunct(']')){
+				if(type != TOKEN_ID){
+					return Error("attribute name expected");
+				}
+				string name = token;
+				Advance();
+				if(!IsPunct('=')){
+					return Error("\"=\" expected after attribute name");
+				}
+				Advance();
+				if(type != TOKEN_ID){
+					return Error("attribute value expected");
+				}
+				if(name == "label"){attributes.hasLabel = true; attributes.label = token;}
+				else if(name == "pos"){attributes.hasPos = true; attributes.pos = token;}
+				else if(name == "dir"){attributes.hasDir = true; attributes.dir = token;}
+				Advance();
+				if(IsPunct(',') || IsPunct(';')){
+					Advance();
+				}
+			}
+			Advance();
+		}
+		return true;
+	}
+
+	bool SkipGraphAttribute(){
+		Advance();
+		if(type != TOKEN_ID){
+			return Error("attribute value expected");
+		}
+		Advance();
+		return true;
+	}
+
+	// node:port or node:port:compass
+	bool SkipPort(){
+		for(int i = 0; i < 2 && IsPunct(':'); i++){
+			Advance();
+			if(type != TOKEN_ID){
+				return Error("port expected after \":\"");
+			}
+			Advance();
+		}
+		return true;
+	}
+
+	void Advance(){
+		type = lexer.Next(token);
+	}
+
+	bool Is(const char* keyword){
+		return type == TOKEN_ID && strcasecmp(token.c_str(), keyword) == 0;
+	}
+
+	bool IsPunct(char punct){
+		return type == TOKEN_PUNCT && token[0] == punct;
+	}
+
+	bool Error(const char* message){
+		if(type == TOKEN_ERROR){
+			message = "invalid token";
+		}
+		cout << "[ERROR] Syntax error line " << lexer.GetLine() << " of DOT file \"" << path << "\" (" << message << ") ; the rest of the file has been ignored" << endl;
+		return false;
+	}
+
+	DotLexer lexer;
+	TokenType type;
+	string token;				// Text of the current token
+	vector<string> ids;			// Node identifiers of the current statement
+	vector<DotScope> scopes;		// Default attributes of the graph and of the opened subgraphs
+	unordered_map<string, Node*> idToNode;	// Nodes already read
+	bool directed;
+	float scale;
+	Graph& graph;
+	string path;
+
+};
+
+bool DotFormat::Load(string path, float scale, Graph& graph){
+	MappedFile file;
+	if(!file.Open(path)){
+		cout << "[ERROR] Failed to open DOT file \"" << path << "\" ; no node and edge as been imported" << endl;
+		return false;
+	}
+	DotReader reader(file.GetData(), file.GetSize(), scale, graph, path);
+	return reader.Read();
+}
@@ -0,0 +1,201 @@
+#include "../../include/io/DotPatchFile.h"
+#include "../../include/io/DotWriter.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+const size_t DotPatchFile::BUFFER_SIZE;
+
+DotPatchFile::DotPatchFile(){
+	fd = -1;
+	failed = false;
+	Forget();
+}
+
+DotPatchFile::~DotPatchFile(){
+	if(fd >= 0){
+		close(fd);
+	}
+}
+
+bool DotPatchFile::Resume(string path, float scale){
+	struct stat status;				// Size and modification time of the file
+	if(this->path.empty() || path != this->path || scale != this->scale){
+		return false;
+	}
+	// A file more than half blank is written again
+	if(deadBytes > liveBytes){
+		return false;
+	}
+	fd = open(path.c_str(), O_RDWR);
+	if(fd < 0){
+		return false;
+	}
+	// The file must be exactly the one written by the last patch
+	if(fstat(fd, &status) != 0 || (unsigned long long) status.st_size != fileSize || status.st_mtim.tv_sec != modifiedSec || status.st_mtim.tv_nsec != modifiedNsec){
+		close(fd);
+		fd = -1;
+		return false;
+	}
+	if(lseek(fd, end, SEEK_SET) < 0){
+		close(fd);
+		fd = -1;
+		return false;
+	}
+	failed = false;
+	return true;
+}
+
+bool DotPatchFile::Create(string path, float scale){
+	DotWriter header;				// Opening of the graph
+	Forget();
+	fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0){
+		return false;
+	}
+	this->path = path;
+	this->scale = scale;
+	header.WriteHeader();
+	pending.assign(header.GetData(), header.GetSize());
+	end = pending.size();
+	return true;
+}
+
+void DotPatchFile::WriteBlock(long long id, string_view text){
+	unordered_map<long long, Block>::iterator block = blocks.find(id);
+	if(block == blocks.end()){
+		Append(id, text);
+		return;
+	}
+	if(text.size() <= block->second.capacity){
+		Overwrite(block->second, text);
+		return;
+	}
+	// The block has grown too much : its place is blanked and it moves to the end
+	Overwrite(block->second, "");
+	liveBytes -= block->second.capacity;
+	deadBytes += block->second.capacity;
+	blocks.erase(block);
+	Append(id, text);
+}
+
+void DotPatchFile::EraseBlock(long long id){
+	unordered_map<long long, Block>::iterator block = blocks.find(id);
+	if(block == blocks.end()){
+		return;
+	}
+	Overwrite(block->second, "");
+	liveBytes -= block->second.capacity;
+	deadBytes += block->second.capacity;
+	blocks.erase(block);
+}
+
+bool DotPatchFile::Finish(){
+	DotWriter footer;				// Closing of the graph
+	struct stat status;				// Modification time of the written file
+	if(fd < 0){
+		return false;
+	}
+	footer.WriteFooter();
+	pending.append(footer.GetData(), footer.GetSize());
+	WriteAll(pending);
+	pending.clear();
+	// Blocks moved to the end may leave a shorter file
+	if(ftruncate(fd, end + footer.GetSize()) != 0 || fstat(fd, &status) != 0){
+		failed = true;
+	}
+	if(close(fd) != 0){
+		failed = true;
+	}
+	fd = -1;
+	if(failed){
+		Forget();
+		return false;
+	}
+	fileSize = status.st_size;
+	modifiedSec = status.st_mtim.tv_sec;
+	modifiedNsec = status.st_mtim.tv_nsec;
+	return true;
+}
+
+bool DotPatchFile::IsStarted(){
+	return !path.empty();
+}
+
+void DotPatchFile::Append(long long id, string_view text){
+	// Room is left after the text, so the block can grow a little without moving
+	Block block;
+	block.offset = end;
+	block.capacity = text.size() + text.size() / 4 + 16;
+	pending.append(text);
+	pending.append(block.capacity - text.size() - 1, ' ');
+	pending.push_back('\n');
+	blocks[id] = block;
+	end += block.capacity;
+	liveBytes += block.capacity;
+	if(pending.size() >= BUFFER_SIZE){
+		WriteAll(pending);
+		pending.clear();
+	}
+}
+
+void DotPatchFile::WriteAll(string_view text){
+	// A single write can be partial or interrupted by a signal
+	while(!text.empty() && !failed){
+		ssize_t result = write(fd, text.data(), text.size());
+		if(result < 0 && errno == EINTR){
+			continue;
+		}
+		if(result <= 0){
+			failed = true;
+			break;
+		}
+		text.remove_prefix(result);
+	}
+}
+
+void DotPatchFile::Overwrite(const Block& block, string_view text){
+	// Appended blocks have to be in the file before one of them is overwritten
+	if(block.offset + block.capacity > end - pending.size()){
+		WriteAll(pending);
+		pending.clear();
+	}
+	padded.assign(text.data(), text.size());
+	if(text.size() < block.capacity){
+		padded.append(block.capacity - text.size() - 1, ' ');
+		padded.push_back('\n');
+	}
+	for(size_t written = 0; written < padded.size() && !failed;){
+		ssize_t result = pwrite(fd, padded.data() + written, padded.size() - written, block.offset + written);
+		if(result < 0 && errno == EINTR){
+			continue;
+		}
+		if(result <= 0){
+			failed = true;
+			break;
+		}
+		written += result;
+	}
+}
+
+void DotPatchFile::Forget(){
+	if(fd >= 0){
+		close(fd);
+		fd = -1;
+	}
+	blocks.clear();
+	path.clear();
+	pending.clear();
+	scale = 0;
+	end = 0;
+	liveBytes = 0;
+	deadBytes = 0;
+	fileSize = 0;
+	modifiedSec = 0;
+	modifiedNsec = 0;
+	failed = false;
+}
@@ -0,0 +1,109 @@
+#include "../../include/io/DotWriter.h"
+
+using namespace std;
+
+void DotWriter::WriteHeader(){
+	Write("digraph LIEGE{\n");
+}
+
+void DotWriter::WriteFooter(){
+	Write("}\n");
+}
+
+void DotWriter::WriteNode(long long i, string_view label, bool fixedPos, float x, float y, float scale){
+	Write('\t');
+	WriteInt(i);
+	Write("[\n\t\tlabel = \"");
+	WriteEscaped(label);
+	Write("\"\n");
+	if(fixedPos && scale > 0){
+		Write("\t\tpos = \"");
+		WriteFloat(x * scale);
+		Write(',');
+		WriteFloat(-y * scale);
+		Write("\"\n");
+	}
+	Write("\t]\n");
+}
+
+void DotWriter::WriteEdge(long long fromIndex, long long toIndex, string_view label){
+	Write('\t');
+	WriteInt(fromIndex);
+	Write(" -> ");
+	WriteInt(toIndex);
+	Write(" [label = \"");
+	WriteEscaped(label);
+	Write("\"]\n");
+}
+
+void DotWriter::WriteEdgeDefaults(string_view dir, bool hasLabel, string_view label){
+	if(dir.empty() && !hasLabel){
+		return;
+	}
+	Write("\tedge [");
+	WriteAttributes(dir, hasLabel, label);
+	Write("]\n");
+}
+
+void DotWriter::WriteCompactNode(long long i, string_view label, bool fixedPos, float x, float y, float scale){
+	Write('\t');
+	WriteInt(i);
+	Write(" [label = \"");
+	WriteEscaped(label);
+	Write('"');
+	if(fixedPos && scale > 0){
+		Write(", pos = \"");
+		WriteFloat(x * scale);
+		Write(',');
+		WriteFloat(-y * scale);
+		Write('"');
+	}
+	Write("]\n");
+}
+
+void DotWriter::WriteCompactEdge(long long fromIndex, long long toIndex, string_view dir, bool hasLabel, string_view label){
+	Write('\t');
+	WriteInt(fromIndex);
+	Write(" -> ");
+	WriteInt(toIndex);
+	if(!dir.empty() || hasLabel){
+		Write(" [");
+		WriteAttributes(dir, hasLabel, label);
+		Write(']');
+	}
+	Write('\n');
+}
+
+void DotWriter::WriteAttributes(string_view dir, bool hasLabel, string_view label){
+	if(!dir.empty()){
+		Write("dir = ");
+		Write(dir);
+	}
+	if(!dir.empty() && hasLabel){
+		Write(", ");
+	}
+	if(hasLabel){
+		Write("label = \"");
+		WriteEscaped(label);
+		Write('"');
+	}
+}
+
+void DotWriter::WriteEscaped(string_view text){
+	// Most labels have nothing to escape : write them at once
+	for(size_t special = text.find_first_of("\"\\"); special != string_view::npos; special = text.find_first_of("\"\\")){
+		Write(text.substr(0, special));
+		if(text[special] == '"'){
+			Write("\\\"");
+		}
+		// A lone backslash before the closing quote, a backslash or a line break would be read as an escape
+		else if(special + 1 == text.size() || text[special + 1] == '"' || text[special + 1] == '\\' || text[special + 1] == '\n' || text[special + 1] == '\r'){
+			Write("\\\\");
+		}
+		else{
+			Write('\\');
+		}
+		text.remove_prefix(special + 1);
+	}
+	Write(text);
+}
@@ -0,0 +1,253 @@
+#include "../../include/io/EdgeListFormat.h"
+#include "../../include/io/MappedFile.h"
+#include "../../include/model/CsrSnapshot.h"
+#include "../../include/model/Graph.h"
+
+#include <deque>
+#include <string.h>
+#include <string_view>
+#include <thread>
+
+using namespace std;
+
+// Minimum number of bytes for a chunk : smaller files are not worth a thread
+static const size_t MIN_CHUNK_SIZE = 1 << 20;
+
+// Edge read in a chunk, nodes are referenced by their index in the chunk
+struct ChunkEdge{
+	uint32_t source;
+	uint32_t target;
+	string_view label;
+};
+
+// Result of the parsing of a chunk
+struct Chunk{
+	const char* begin;
+	const char* end;
+	vector<string_view> names;			// Node names in order of first appearance in the chunk
+	vector<ChunkEdge> edges;			// Edges in order of appearance in the chunk
+	deque<string> unescaped;			// Quoted fields with doubled double quotes, copied once unescaped (the mapping is read-only)
+	size_t malformedLines;				// Lines without source or target
+};
+
+// Remove surrounding spaces and double quotes of a field
+static string_view Trim(string_view field){
+	while(!field.empty() && (field.front() == ' ' || field.front() == '\t')){
+		field.remove_prefix(1);
+	}
+	while(!field.empty() && (field.back() == ' ' || field.back() == '\t' || field.back() == '\r')){
+		field.remove_suffix(1);
+	}
+	if(field.size() >= 2 && field.front() == '"' && field.back() == '"'){
+		field = field.substr(1, field.size() - 2);
+	}
+	return field;
+}
+
+// Read a field with Trim : in a quoted field, a double quote written twice is kept once
+static string_view ReadField(string_view field, deque<string>& unescaped){
+	string_view trimmed = Trim(field);
+	// Trim has removed double quotes if the character before the field is one of them
+	bool quoted = trimmed.data() != field.data() && trimmed.data()[-1] == '"';
+	if(!quoted || trimmed.find("\"\"") == string_view::npos){
+		return trimmed;
+	}
+	string text;
+	text.reserve(trimmed.size());
+	for(size_t i = 0; i < trimmed.size(); i++){
+		text += trimmed[i];
+		// Skip the second double quote of a pair
+		if(trimmed[i] == '"' && i + 1 < trimmed.size() && trimmed[i + 1] == '"'){
+			i++;
+		}
+	}
+	unescaped.push_back(text);
+	return unescaped.back();
+}
+
+// Find the next separator which is not between double quotes
+static size_t FindSeparator(string_view text, char separator, size_t first){
+	bool quoted = false;
+	for(size_t i = first; i < text.size(); i++){
+		if(text[i] == '"'){
+			quoted = !quoted;
+		}
+		else if(text[i] == separator && !quoted){
+			return i;
+		}
+	}
+	return string_view::npos;
+}
+
+// Open-addressing table from names to their index (std::unordered_map allocates a node per name, which is far slower for millions of lookups)
+class NameTable{
+
+public:
+
+	NameTable() : slots(1 << 12), mask((1 << 12) - 1){}
+
+	// Give the index of a name in a chunk, add the name if it is new
+	uint32_t Intern(vector<string_view>& names, string_view name){
+		uint64_t hash = Hash(name);
+		for(uint64_t i = hash & mask;; i = (i + 1) & mask){
+			Slot& slot = slots[i];
+			if(slot.index == 0){
+				// Not found : add it, and keep the table at most half full
+				slot.hash = hash;
+				slot.index = names.size() + 1;
+				names.push_back(name);
+				if(2 * names.size() > slots.size()){
+					Grow();
+				}
+				return names.size() - 1;
+			}
+			if(slot.hash == hash && names[slot.index - 1] == name){
+				return slot.index - 1;
+			}
+		}
+	}
+
+private:
+
+	// Index of a name plus one (0 for an empty slot), with its hash to skip most string comparisons
+	struct Slot{
+		uint64_t hash = 0;
+		uint32_t index = 0;
+	};
+
+	// FNV-1a
+	static uint64_t Hash(string_view name){
+		uint64_t hash = 14695981039346656037ull;
+		for(size_t i = 0; i < name.size(); i++){
+			hash = (hash ^ (unsigned char) name[i]) * 1099511628211ull;
+		}
+		return hash ^ (hash >> 32);
+	}
+
+	void Grow(){
+		vector<Slot> old(2 * slots.size());
+		old.swap(slots);
+		mask = slots.size() - 1;
+		for(vector<Slot>::iterator slot = old.begin(); slot != old.end(); ++slot){
+			if(slot->index == 0){
+				continue;
+			}
+			uint64_t i = slot->hash & mask;
+			while(slots[i].index != 0){
+				i = (i + 1) & mask;
+			}
+			slots[i] = *slot;
+		}
+	}
+
+	vector<Slot> slots;
+	uint64_t mask;
+
+};
+
+// Parse all lines of a chunk
+static void ParseChunk(Chunk* chunk, char separator){
+	NameTable nameToIndex;
+	chunk->malformedLines = 0;
+	for(const char* line = chunk->begin; line < chunk->end;){
+		const char* lineEnd = (const char*) memchr(line, '\n', chunk->end - line);
+		if(lineEnd == NULL){
+			lineEnd = chunk->end;
+		}
+		string_view text(line, lineEnd - line);
+		line = lineEnd + 1;
+		// Ignore empty lines and comments
+		string_view trimmed = Trim(text);
+		if(trimmed.empty() || trimmed.front() == '#'){
+			continue;
+		}
+		// Source and target are the two first fields, the label is the rest of the line
+		size_t first = FindSeparator(text, separator, 0);
+		if(first == string_view::npos){
+			chunk->malformedLines++;
+			continue;
+		}
+		size_t second = FindSeparator(text, separator, first + 1);
+		string_view source = ReadField(text.substr(0, first), chunk->unescaped);
+		string_view target = ReadField(second == string_view::npos ? text.substr(first + 1) : text.substr(first + 1, second - first - 1), chunk->unescaped);
+		string_view label = second == string_view::npos ? string_view() : ReadField(text.substr(second + 1), chunk->unescaped);
+		if(source.empty() || target.empty()){
+			chunk->malformedLines++;
+			continue;
+		}
+		ChunkEdge edge;
+		edge.source = nameToIndex.Intern(chunk->names, source);
+		edge.target = nameToIndex.Intern(chunk->names, target);
+		edge.label = label;
+		chunk->edges.push_back(edge);
+	}
+}
+
+bool EdgeListFormat::Load(string path, char separator, unsigned threadCount, Graph& graph){
+	MappedFile file;
+	if(!file.Open(path)){
+		cout << "[ERROR] Failed to open edge list file \"" << path << "\" ; no node and edge as been imported" << endl;
+		return false;
+	}
+	const char* data = file.GetData();
+	size_t size = file.GetSize();
+	// Split the file in chunks ending on a line break, one chunk per thread
+	size_t threads = threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+	size_t chunkCount = max((size_t) 1, min(threads, size / MIN_CHUNK_SIZE));
+	vector<Chunk> chunks(chunkCount);
+	const char* begin = data;
+	for(size_t i = 0; i < chunkCount; i++){
+		const char* end = data + size * (i + 1) / chunkCount;
+		if(i + 1 == chunkCount){
+			end = data + size;
+		}
+		else if(end < begin){
+			end = begin;
+		}
+		else{
+			const char* lineEnd = (const char*) memchr(end, '\n', data + size - end);
+			end = lineEnd == NULL ? data + size : lineEnd + 1;
+		}
+		chunks[i].begin = begin;
+		chunks[i].end = end;
+		begin = end;
+	}
+	// Parse chunks in parallel
+	vector<thread> workers;
+	for(size_t i = 1; i < chunkCount; i++){
+		workers.push_back(thread(ParseChunk, &chunks[i], separator));
+	}
+	ParseChunk(&chunks[0], separator);
+	for(vector<thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker){
+		worker->join();
+	}
+	// Merge chunks in file order, so nodes and edges are numbered in order of appearance in the file
+	NameTable nameToIndex;
+	vector<string_view> names;
+	vector<pair<uint32_t, uint32_t> > edgeList;
+	vector<string_view> labels;
+	size_t malformedLines = 0;
+	size_t edgeCount = 0;
+	for(vector<Chunk>::iterator chunk = chunks.begin(); chunk != chunks.end(); ++chunk){
+		edgeCount += chunk->edges.size();
+	}
+	edgeList.reserve(edgeCount);
+	labels.reserve(edgeCount);
+	for(vector<Chunk>::iterator chunk = chunks.begin(); chunk != chunks.end(); ++chunk){
+		vector<uint32_t> localToIndex(chunk->names.size());
+		for(size_t i = 0; i < chunk->names.size(); i++){
+			localToIndex[i] = nameToIndex.Intern(names, chunk->names[i]);
+		}
+		for(vector<ChunkEdge>::iterator edge = chunk->edges.begin(); edge != chunk->edges.end(); ++edge){
+			edgeList.push_back(make_pair(localToIndex[edge->source], localToIndex[edge->target]));
+			labels.push_back(edge->label);
+		}
+		malformedLines += chunk->malformedLines;
+	}
+	// Nodes and edges are created in bulk, labels are copied from the mapping before it is closed
+	graph.Thaw(CsrSnapshot(names.size(), edgeList, vector<float>(), names, labels));
+	if(malformedLines > 0){
+		cout << "[WARNING] " << malformedLines << " lines without source or target in edge list file \"" << path << "\" ; these lines have been ignored" << endl;
+	}
+	return true;
+}
@@ -0,0 +1,53 @@
+#include "../../include/io/GraphmlWriter.h"
+
+using namespace std;
+
+void GraphmlWriter::WriteHeader(){
+	Write("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+		"<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xmlns:y=\"http://www.yworks.com/xml/graphml\" xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns http://www.yworks.com/xml/schema/graphml/1.1/ygraphml.xsd\">\n"
+		"  <!--Created by LIEGE-->\n"
+		"  <key for=\"node\" id=\"d6\" yfiles.type=\"nodegraphics\"/>\n"
+		"  <key for=\"edge\" id=\"d10\" yfiles.type=\"edgegraphics\"/>\n"
+		"  <graph edgedefault=\"directed\" id=\"G\">\n");
+}
+
+void GraphmlWriter::WriteFooter(){
+	Write("  </graph>\n</graphml>\n");
+}
+
+void GraphmlWriter::WriteNode(long long i, string_view label, float x, float y){
+	Write("    <node id=\"n");
+	WriteInt(i);
+	Write("\">\n      <data key=\"d6\">\n        <y:ShapeNode>\n          <y:Geometry height=\"30.0\" width=\"30.0\" x=\"");
+	WriteFloatExact(x);
+	Write("\" y=\"");
+	WriteFloatExact(y);
+	Write("\"/>\n"
+		"          <y:Fill color=\"#FFCC00\" transparent=\"false\"/>\n"
+		"          <y:BorderStyle color=\"#000000\" raised=\"false\" type=\"line\" width=\"1.0\"/>\n"
+		"          <y:NodeLabel alignment=\"center\" autoSizePolicy=\"content\" modelName=\"internal\" modelPosition=\"c\" visible=\"true\">");
+	WriteEscaped(label);
+	Write("</y:NodeLabel>\n"
+		"          <y:Shape type=\"rectangle\"/>\n"
+		"        </y:ShapeNode>\n      </data>\n    </node>\n");
+}
+
+void GraphmlWriter::WriteEdge(long long i, long long fromIndex, long long toIndex, string_view label, bool isBidirectional){
+	Write("    <edge id=\"e");
+	WriteInt(i);
+	Write("\" source=\"n");
+	WriteInt(fromIndex);
+	Write("\" target=\"n");
+	WriteInt(toIndex);
+	Write("\">\n      <data key=\"d10\">\n        <y:PolyLineEdge>\n"
+		"          <y:LineStyle color=\"#000000\" type=\"line\" width=\"1.0\"/>\n"
+		"          <y:Arrows source=\"");
+	Write(isBidirectional ? "standard" : "none");
+	Write("\" target=\"standard\"/>\n");
+	if(!label.empty()){
+		Write("          <y:EdgeLabel alignment=\"center\" modelName=\"centered\" modelPosition=\"center\" visible=\"true\">");
+		WriteEscaped(label);
+		Write("</y:EdgeLabel>\n");
+	}
+	Write("        </y:PolyLineEdge>\n      </data>\n    </edge>\n");
+}
@@ -0,0 +1,178 @@
+#include "../../include/io/GraphvizRenderer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+extern char** environ;
+
+using namespace std;
+
+GraphvizRenderer::GraphvizRenderer(){
+	pid = -1;
+	inputFd = -1;
+	exitStatus = -1;
+	sigemptyset(&previousMask);
+}
+
+GraphvizRenderer::~GraphvizRenderer(){
+	if(pid >= 0){
+		Wait();
+	}
+}
+
+void GraphvizRenderer::SetEngine(string engine){
+	this->engine = engine;
+}
+
+void GraphvizRenderer::AddOutput(string format, string path){
+	outputs.push_back(make_pair(format, path));
+}
+
+bool GraphvizRenderer::HasOutputs(){
+	return !outputs.empty();
+}
+
+bool GraphvizRenderer::Start(string pathDot){
+	if(pid >= 0){
+		errors = "Graphviz is already running";
+		return false;
+	}
+	exitStatus = -1;
+	errors.clear();
+	// Arguments : every image is drawn by the same process from the same layout
+	vector<string> arguments;
+	arguments.push_back("dot");
+	if(!engine.empty()){
+		arguments.push_back("-K" + engine);
+	}
+	for(vector<pair<string, string> >::iterator output = outputs.begin(); output != outputs.end(); ++output){
+		arguments.push_back("-T" + output->first);
+		arguments.push_back("-o" + output->second);
+	}
+	if(!pathDot.empty()){
+		arguments.push_back(pathDot);
+	}
+	vector<char*> argv;
+	for(vector<string>::iterator argument = arguments.begin(); argument != arguments.end(); ++argument){
+		argv.push_back(&(*argument)[0]);
+	}
+	argv.push_back(NULL);
+	// Pipes are closed on exec, except the ends duplicated on the standard input and error of Graphviz
+	int inputPipe[2] = {-1, -1};
+	int errorPipe[2] = {-1, -1};
+	if(pipe2(errorPipe, O_CLOEXEC) != 0 || (pathDot.empty() && pipe2(inputPipe, O_CLOEXEC) != 0)){
+		errors = strerror(errno);
+		for(int i = 0; i < 2; i++){
+			if(errorPipe[i] >= 0){
+				close(errorPipe[i]);
+			}
+		}
+		return false;
+	}
+	// Writing into the pipe after the end of Graphviz has to fail with EPIPE instead of killing this process
+	sigset_t sigpipe;
+	sigemptyset(&sigpipe);
+	sigaddset(&sigpipe, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &sigpipe, &previousMask);
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	if(inputPipe[0] >= 0){
+		posix_spawn_file_actions_adddup2(&actions, inputPipe[0], STDIN_FILENO);
+	}
+	posix_spawn_file_actions_adddup2(&actions, errorPipe[1], STDERR_FILENO);
+	// Graphviz gets the signal mask and the SIGPIPE behaviour of a normal process
+	posix_spawnattr_t attributes;
+	posix_spawnattr_init(&attributes);
+	posix_spawnattr_setsigmask(&attributes, &previousMask);
+	posix_spawnattr_setsigdefault(&attributes, &sigpipe);
+	posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+	int result = posix_spawnp(&pid, "dot", &actions, &attributes, &argv[0], environ);
+	posix_spawnattr_destroy(&attributes);
+	posix_spawn_file_actions_destroy(&actions);
+	close(errorPipe[1]);
+	if(inputPipe[0] >= 0){
+		close(inputPipe[0]);
+	}
+	if(result != 0){
+		pid = -1;
+		errors = string("Failed to launch \"dot\" : ") + strerror(result);
+		close(errorPipe[0]);
+		if(inputPipe[1] >= 0){
+			close(inputPipe[1]);
+		}
+		pthread_sigmask(SIG_SETMASK, &previousMask, NULL);
+		return false;
+	}
+	inputFd = inputPipe[1];
+	errorReader = thread(&GraphvizRenderer::ReadErrors, this, errorPipe[0]);
+	return true;
+}
+
+int GraphvizRenderer::GetInput(){
+	return inputFd;
+}
+
+bool GraphvizRenderer::Wait(){
+	if(pid < 0){
+		return false;
+	}
+	// End of input : Graphviz can draw the images
+	if(inputFd >= 0){
+		close(inputFd);
+		inputFd = -1;
+	}
+	int status = 0;
+	pid_t result;
+	do{
+		result = waitpid(pid, &status, 0);
+	}while(result < 0 && errno == EINTR);
+	pid = -1;
+	errorReader.join();
+	while(!errors.empty() && errors[errors.size() - 1] == '\n'){
+		errors.erase(errors.size() - 1);
+	}
+	exitStatus = (result >= 0 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+	if(result >= 0 && WIFSIGNALED(status)){
+		errors += string("Graphviz has been killed by signal ") + strsignal(WTERMSIG(status));
+	}
+	// Discard a SIGPIPE raised by a write after the end of Graphviz, then restore the signal mask
+	sigset_t sigpipe;
+	sigemptyset(&sigpipe);
+	sigaddset(&sigpipe, SIGPIPE);
+	sigset_t pending;
+	sigpending(&pending);
+	if(sigismember(&pending, SIGPIPE) && !sigismember(&previousMask, SIGPIPE)){
+		struct timespec noWait = {0, 0};
+		sigtimedwait(&sigpipe, NULL, &noWait);
+	}
+	pthread_sigmask(SIG_SETMASK, &previousMask, NULL);
+	return exitStatus == 0;
+}
+
+int GraphvizRenderer::GetExitStatus(){
+	return exitStatus;
+}
+
+const string& GraphvizRenderer::GetErrors(){
+	return errors;
+}
+
+void GraphvizRenderer::ReadErrors(int fd){
+	char chunk[4096];
+	while(true){
+		ssize_t count = read(fd, chunk, sizeof(chunk));
+		if(count < 0 && errno == EINTR){
+			continue;
+		}
+		if(count <= 0){
+			break;
+		}
+		errors.append(chunk, count);
+	}
+	close(fd);
+}
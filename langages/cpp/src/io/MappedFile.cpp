@@ -0,0 +1,57 @@
+#include "../../include/io/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+MappedFile::MappedFile(){
+	data = NULL;
+	size = 0;
+}
+
+MappedFile::~MappedFile(){
+	Close();
+}
+
+bool MappedFile::Open(string path){
+	Close();
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0){
+		return false;
+	}
+	struct stat status;
+	if(fstat(fd, &status) != 0){
+		close(fd);
+		return false;
+	}
+	// Nothing to map for an empty file, but it is still a valid file
+	if(status.st_size == 0){
+		close(fd);
+		return true;
+	}
+	void* mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file : the descriptor is not needed anymore
+	close(fd);
+	if(mapping == MAP_FAILED){
+		return false;
+	}
+	// Files are always read from the first to the last byte
+	madvise(mapping, status.st_size, MADV_SEQUENTIAL);
+	data = (const char*) mapping;
+	size = status.st_size;
+	return true;
+}
+
+void MappedFile::Close(){
+	if(data != NULL){
+		munmap((void*) data, size);
+	}
+	data = NULL;
+	size = 0;
+}
+
+const char* MappedFile::GetData(){return data;}
+size_t MappedFile::GetSize(){return size;}
@@ -0,0 +1,132 @@
+#include "../../include/io/PngFormat.h"
+#include "../../include/io/BufferedWriter.h"
+
+#include <algorithm>
+#include <string.h>
+
+using namespace std;
+
+// Biggest payload of a stored deflate block
+static const size_t STORED_BLOCK_SIZE = 65535;
+
+// CRC of each byte value (polynomial 0xEDB88320)
+static vector<uint32_t> BuildCrcTable(){
+	vector<uint32_t> table(256);
+	for(uint32_t n = 0; n < 256; n++){
+		uint32_t c = n;
+		for(int k = 0; k < 8; k++){
+			c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+		}
+		table[n] = c;
+	}
+	return table;
+}
+
+// Append a big-endian 32 bits value
+static void PutBe32(vector<uint8_t>& out, uint32_t value){
+	for(int shift = 24; shift >= 0; shift -= 8){
+		out.push_back((value >> shift) & 0xFF);
+	}
+}
+
+// Write a chunk : length, type, data, CRC of type and data
+static void WriteChunk(BufferedWriter& out, const char* type, const vector<uint8_t>& data){
+	vector<uint8_t> head;
+	PutBe32(head, data.size());
+	head.insert(head.end(), type, type + 4);
+	uint32_t crc = PngFormat::Crc32(0, &head[4], 4);
+	crc = PngFormat::Crc32(crc, data.data(), data.size());
+	vector<uint8_t> tail;
+	PutBe32(tail, crc);
+	out.Write(string_view((const char*) head.data(), head.size()));
+	out.Write(string_view((const char*) data.data(), data.size()));
+	out.Write(string_view((const char*) tail.data(), tail.size()));
+}
+
+bool PngFormat::Save(const vector<uint8_t>& pixels, unsigned width, unsigned height, string path){
+	BufferedWriter out;
+	if(!out.Open(path)){
+		return false;
+	}
+	out.Write(string_view("\x89PNG\r\n\x1A\n", 8));
+	// Header : size, 8 bits per channel, RGBA, deflate, adaptive filters, no interlace
+	vector<uint8_t> header;
+	PutBe32(header, width);
+	PutBe32(header, height);
+	header.push_back(8);
+	header.push_back(6);
+	header.push_back(0);
+	header.push_back(0);
+	header.push_back(0);
+	WriteChunk(out, "IHDR", header);
+	// Raw data : each row starts with filter 0 (none)
+	size_t rowSize = 1 + (size_t) width * 4;
+	size_t total = rowSize * height;
+	uint32_t adler = 1;
+	vector<uint8_t> chunk;
+	size_t position = 0;
+	do{
+		chunk.clear();
+		if(position == 0){
+			// zlib header : deflate, 32K window, no dictionary, fastest level
+			chunk.push_back(0x78);
+			chunk.push_back(0x01);
+		}
+		size_t size = min(STORED_BLOCK_SIZE, total - position);
+		bool last = position + size == total;
+		chunk.push_back(last ? 1 : 0);
+		chunk.push_back(size & 0xFF);
+		chunk.push_back(size >> 8);
+		chunk.push_back(~size & 0xFF);
+		chunk.push_back((~size >> 8) & 0xFF);
+		size_t payload = chunk.size();
+		chunk.resize(payload + size);
+		// Copy the rows, or parts of rows, of this block
+		for(size_t copied = 0; copied < size; ){
+			size_t row = (position + copied) / rowSize;
+			size_t column = (position + copied) % rowSize;
+			if(column == 0){
+				chunk[payload + copied++] = 0;
+				continue;
+			}
+			size_t count = min(size - copied, rowSize - column);
+			memcpy(&chunk[payload + copied], &pixels[row * (rowSize - 1) + column - 1], count);
+			copied += count;
+		}
+		adler = Adler32(adler, &chunk[payload], size);
+		if(last){
+			PutBe32(chunk, adler);
+		}
+		WriteChunk(out, "IDAT", chunk);
+		position += size;
+	}while(position < total);
+	WriteChunk(out, "IEND", vector<uint8_t>());
+	return out.Close();
+}
+
+uint32_t PngFormat::Crc32(uint32_t crc, const uint8_t* data, size_t size){
+	static const vector<uint32_t> table = BuildCrcTable();
+	crc = ~crc;
+	for(size_t i = 0; i < size; i++){
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+uint32_t PngFormat::Adler32(uint32_t adler, const uint8_t* data, size_t size){
+	uint32_t a = adler & 0xFFFF;
+	uint32_t b = adler >> 16;
+	while(size > 0){
+		// Sums cannot overflow before 5552 bytes
+		size_t count = min(size, (size_t) 5552);
+		for(size_t i = 0; i < count; i++){
+			a += data[i];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+		data += count;
+		size -= count;
+	}
+	return (b << 16) | a;
+}
@@ -0,0 +1,313 @@
+#include "../../include/io/Rasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <math.h>
+#include <thread>
+
+using namespace std;
+
+const int Rasterizer::TILE_SIZE;
+const uint32_t Rasterizer::NO_COLOR;
+
+// Bound a value (before converting it to an integer)
+static inline float Clamp(float value, float low, float high){
+	return min(high, max(low, value));
+}
+
+// Coverage of a pixel whose center is at a signed distance from the border of a shape (negative inside)
+static inline float Coverage(float distance){
+	return min(1.0f, max(0.0f, 0.5f - distance));
+}
+
+Rasterizer::Rasterizer(unsigned width, unsigned height, uint32_t background){
+	this->width = width;
+	this->height = height;
+	tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+	tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+	threadCount = 1;
+	tiles.resize((size_t) tilesX * tilesY);
+	pixels.resize((size_t) width * height * 4);
+	for(size_t i = 0; i < pixels.size(); i += 4){
+		pixels[i] = (background >> 16) & 0xFF;
+		pixels[i + 1] = (background >> 8) & 0xFF;
+		pixels[i + 2] = background & 0xFF;
+		pixels[i + 3] = 0xFF;
+	}
+}
+
+void Rasterizer::SetThreads(unsigned threadCount){
+	this->threadCount = threadCount;
+}
+
+void Rasterizer::DrawLine(float x0, float y0, float x1, float y1, float thickness, uint32_t color){
+	Shape shape = {LINE, {x0, y0, x1, y1, 0, 0}, thickness, color, NO_COLOR};
+	float margin = thickness / 2 + 1;
+	Queue(shape, min(x0, x1) - margin, min(y0, y1) - margin, max(x0, x1) + margin, max(y0, y1) + margin);
+}
+
+void Rasterizer::DrawTriangle(float x0, float y0, float x1, float y1, float x2, float y2, uint32_t color){
+	Shape shape = {TRIANGLE, {x0, y0, x1, y1, x2, y2}, 0, color, NO_COLOR};
+	Queue(shape, min(x0, min(x1, x2)) - 1, min(y0, min(y1, y2)) - 1, max(x0, max(x1, x2)) + 1, max(y0, max(y1, y2)) + 1);
+}
+
+void Rasterizer::DrawCircle(float x, float y, float radius, uint32_t fill, uint32_t border){
+	Shape shape = {CIRCLE, {x, y, radius, 0, 0, 0}, 0, fill, border};
+	Queue(shape, x - radius - 1, y - radius - 1, x + radius + 1, y + radius + 1);
+}
+
+void Rasterizer::DrawArrow(float x0, float y0, float x1, float y1, float radius, float headSize, bool isBidirectional, uint32_t color){
+	float dx = x1 - x0;
+	float dy = y1 - y0;
+	float length = sqrt(dx * dx + dy * dy);
+	// Loop : a small circle over the top-right of the node
+	if(length < 1e-3f){
+		DrawCircle(x0 + radius * 0.7f, y0 - radius * 0.7f, radius * 0.6f, NO_COLOR, color);
+		return;
+	}
+	// Nothing visible between overlapping circles
+	float visible = length - 2 * radius;
+	if(visible <= 0){
+		return;
+	}
+	float ux = dx / length;
+	float uy = dy / length;
+	float startX = x0 + ux * radius;
+	float startY = y0 + uy * radius;
+	float endX = x1 - ux * radius;
+	float endY = y1 - uy * radius;
+	float head = min(headSize, visible / (isBidirectional ? 2 : 1));
+	// Heads smaller than a pixel are not drawn
+	if(head < 1){
+		DrawLine(startX, startY, endX, endY, 1, color);
+		return;
+	}
+	float lineStart = isBidirectional ? head : 0;
+	DrawLine(startX + ux * lineStart, startY + uy * lineStart, endX - ux * head, endY - uy * head, 1, color);
+	float halfWidth = head * 0.4f;
+	DrawTriangle(endX, endY, endX - ux * head - uy * halfWidth, endY - uy * head + ux * halfWidth, endX - ux * head + uy * halfWidth, endY - uy * head - ux * halfWidth, color);
+	if(isBidirectional){
+		DrawTriangle(startX, startY, startX + ux * head - uy * halfWidth, startY + uy * head + ux * halfWidth, startX + ux * head + uy * halfWidth, startY + uy * head - ux * halfWidth, color);
+	}
+}
+
+void Rasterizer::Queue(const Shape& shape, float minX, float minY, float maxX, float maxY){
+	// Shapes out of the image are forgotten
+	if(maxX < 0 || maxY < 0 || minX >= width || minY >= height){
+		return;
+	}
+	int firstX = (int) max(0.0f, minX) / TILE_SIZE;
+	int firstY = (int) max(0.0f, minY) / TILE_SIZE;
+	int lastX = (int) min((float) width - 1, maxX) / TILE_SIZE;
+	int lastY = (int) min((float) height - 1, maxY) / TILE_SIZE;
+	uint32_t index = shapes.size();
+	shapes.push_back(shape);
+	for(int tileY = firstY; tileY <= lastY; tileY++){
+		int fromX = firstX;
+		int toX = lastX;
+		// A line only covers the tiles along it : compute its columns in this row of tiles
+		if(shape.type == LINE && shape.points[1] != shape.points[3]){
+			const float* p = shape.points;
+			float margin = shape.size / 2 + 1;
+			float slope = (p[2] - p[0]) / (p[3] - p[1]);
+			float bandTop = max(min(p[1], p[3]), (float) tileY * TILE_SIZE - margin);
+			float bandBottom = min(max(p[1], p[3]), (float) (tileY + 1) * TILE_SIZE + margin);
+			float xTop = p[0] + (bandTop - p[1]) * slope;
+			float xBottom = p[0] + (bandBottom - p[1]) * slope;
+			float extent = margin * sqrt(1 + slope * slope);
+			fromX = max(firstX, (int) Clamp(min(xTop, xBottom) - extent, 0, width - 1) / TILE_SIZE);
+			toX = min(lastX, (int) Clamp(max(xTop, xBottom) + extent, 0, width - 1) / TILE_SIZE);
+		}
+		for(int tileX = fromX; tileX <= toX; tileX++){
+			tiles[(size_t) tileY * tilesX + tileX].push_back(index);
+		}
+	}
+}
+
+void Rasterizer::Render(){
+	unsigned threads = threadCount == 0 ? max(1u, thread::hardware_concurrency()) : threadCount;
+	threads = min(threads, (unsigned) tiles.size());
+	// Threads take the next tile to draw until all tiles are drawn
+	atomic<size_t> nextTile(0);
+	if(threads <= 1){
+		for(size_t tile = 0; tile < tiles.size(); tile++){
+			RenderTile(tile);
+		}
+	}
+	else{
+		vector<thread> workers;
+		for(unsigned t = 0; t < threads; t++){
+			workers.push_back(thread([this, &nextTile](){
+				for(size_t tile = nextTile++; tile < tiles.size(); tile = nextTile++){
+					RenderTile(tile);
+				}
+			}));
+		}
+		for(vector<thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker){
+			worker->join();
+		}
+	}
+	shapes.clear();
+	for(vector<vector<uint32_t> >::iterator tile = tiles.begin(); tile != tiles.end(); ++tile){
+		tile->clear();
+	}
+}
+
+void Rasterizer::RenderTile(size_t tile){
+	int left = (tile % tilesX) * TILE_SIZE;
+	int top = (tile / tilesX) * TILE_SIZE;
+	int right = min((int) width, left + TILE_SIZE);
+	int bottom = min((int) height, top + TILE_SIZE);
+	for(vector<uint32_t>::iterator index = tiles[tile].begin(); index != tiles[tile].end(); ++index){
+		const Shape& shape = shapes[*index];
+		switch(shape.type){
+			case LINE : RenderLine(shape, left, top, right, bottom); break;
+			case TRIANGLE : RenderTriangle(shape, left, top, right, bottom); break;
+			case CIRCLE : RenderCircle(shape, left, top, right, bottom); break;
+		}
+	}
+}
+
+void Rasterizer::RenderLine(const Shape& shape, int left, int top, int right, int bottom){
+	const float* p = shape.points;
+	float dx = p[2] - p[0];
+	float dy = p[3] - p[1];
+	float length2 = dx * dx + dy * dy;
+	if(length2 == 0){
+		return;
+	}
+	float inverseLength = 1 / sqrt(length2);
+	float inverseLength2 = inverseLength * inverseLength;
+	float halfThickness = shape.size / 2;
+	float margin = halfThickness + 1;
+	// One span of pixels per row for a steep line, per column for a flat line : few pixels are far from the line
+	bool steep = fabs(dy) >= fabs(dx);
+	float majorStart = steep ? p[1] : p[0];
+	float minorStart = steep ? p[0] : p[1];
+	float majorDelta = steep ? dy : dx;
+	float minorDelta = steep ? dx : dy;
+	int majorFrom = steep ? top : left;
+	int majorTo = steep ? bottom : right;
+	int minorFrom = steep ? left : top;
+	int minorTo = steep ? right : bottom;
+	majorFrom = (int) floor(Clamp(min(majorStart, majorStart + majorDelta) - margin, majorFrom, majorTo));
+	majorTo = (int) ceil(Clamp(max(majorStart, majorStart + majorDelta) + margin, majorFrom, majorTo));
+	minorFrom = (int) floor(Clamp(min(minorStart, minorStart + minorDelta) - margin, minorFrom, minorTo));
+	minorTo = (int) ceil(Clamp(max(minorStart, minorStart + minorDelta) + margin, minorFrom, minorTo));
+	// The line crosses each row (or column) at center, pixels near it are within extent
+	float inverseSlope = minorDelta / majorDelta;
+	float extent = margin * sqrt(length2) / fabs(majorDelta);
+	for(int u = majorFrom; u < majorTo; u++){
+		float pu = u + 0.5f - majorStart;
+		float center = minorStart + pu * inverseSlope;
+		int from = (int) floor(Clamp(center - extent, minorFrom, minorTo));
+		int to = (int) ceil(Clamp(center + extent, from, minorTo));
+		for(int v = from; v < to; v++){
+			float pv = v + 0.5f - minorStart;
+			float px = steep ? pv : pu;
+			float py = steep ? pu : pv;
+			// Distance from the center of the pixel to the segment : to the line between its ends, or to the nearest end
+			float along = (px * dx + py * dy) * inverseLength2;
+			float distance;
+			if(along >= 0 && along <= 1){
+				distance = fabs(px * dy - py * dx) * inverseLength;
+			}
+			else{
+				float ex = along < 0 ? px : px - dx;
+				float ey = along < 0 ? py : py - dy;
+				distance = sqrt(ex * ex + ey * ey);
+			}
+			float coverage = Coverage(distance - halfThickness);
+			if(coverage > 0){
+				Blend(steep ? v : u, steep ? u : v, shape.fill, coverage);
+			}
+		}
+	}
+}
+
+void Rasterizer::RenderTriangle(const Shape& shape, int left, int top, int right, int bottom){
+	const float* p = shape.points;
+	// Normals of edges oriented outwards
+	float area = (p[2] - p[0]) * (p[5] - p[1]) - (p[3] - p[1]) * (p[4] - p[0]);
+	if(area == 0){
+		return;
+	}
+	float orientation = area > 0 ? 1 : -1;
+	float nx[3], ny[3], offset[3];
+	for(int e = 0; e < 3; e++){
+		float ax = p[2 * e], ay = p[2 * e + 1];
+		float bx = p[(2 * e + 2) % 6], by = p[(2 * e + 3) % 6];
+		float length = sqrt((bx - ax) * (bx - ax) + (by - ay) * (by - ay));
+		nx[e] = orientation * (by - ay) / length;
+		ny[e] = -orientation * (bx - ax) / length;
+		offset[e] = -(nx[e] * ax + ny[e] * ay);
+	}
+	int fromX = (int) floor(Clamp(min(p[0], min(p[2], p[4])) - 1, left, right));
+	int toX = (int) ceil(Clamp(max(p[0], max(p[2], p[4])) + 1, left, right));
+	int fromY = (int) floor(Clamp(min(p[1], min(p[3], p[5])) - 1, top, bottom));
+	int toY = (int) ceil(Clamp(max(p[1], max(p[3], p[5])) + 1, top, bottom));
+	for(int y = fromY; y < toY; y++){
+		for(int x = fromX; x < toX; x++){
+			// Signed distance to the farthest edge : negative inside
+			float distance = -1e30f;
+			for(int e = 0; e < 3; e++){
+				distance = max(distance, nx[e] * (x + 0.5f) + ny[e] * (y + 0.5f) + offset[e]);
+			}
+			float coverage = Coverage(distance);
+			if(coverage > 0){
+				Blend(x, y, shape.fill, coverage);
+			}
+		}
+	}
+}
+
+void Rasterizer::RenderCircle(const Shape& shape, int left, int top, int right, int bottom){
+	float cx = shape.points[0];
+	float cy = shape.points[1];
+	float radius = shape.points[2];
+	int fromX = (int) floor(Clamp(cx - radius - 1, left, right));
+	int toX = (int) ceil(Clamp(cx + radius + 1, left, right));
+	int fromY = (int) floor(Clamp(cy - radius - 1, top, bottom));
+	int toY = (int) ceil(Clamp(cy + radius + 1, top, bottom));
+	for(int y = fromY; y < toY; y++){
+		for(int x = fromX; x < toX; x++){
+			float dx = x + 0.5f - cx;
+			float dy = y + 0.5f - cy;
+			float distance = sqrt(dx * dx + dy * dy) - radius;
+			if(shape.fill != NO_COLOR){
+				float coverage = Coverage(distance);
+				if(coverage > 0){
+					Blend(x, y, shape.fill, coverage);
+				}
+			}
+			if(shape.border != NO_COLOR){
+				float coverage = Coverage(fabs(distance) - 0.5f);
+				if(coverage > 0){
+					Blend(x, y, shape.border, coverage);
+				}
+			}
+		}
+	}
+}
+
+inline void Rasterizer::Blend(int x, int y, uint32_t color, float coverage){
+	uint8_t* pixel = &pixels[((size_t) y * width + x) * 4];
+	// Fixed point mix : alpha from 0 to 256
+	int alpha = (int) (coverage * 256 + 0.5f);
+	for(int channel = 0; channel < 3; channel++){
+		int source = (color >> (16 - 8 * channel)) & 0xFF;
+		pixel[channel] += ((source - pixel[channel]) * alpha) >> 8;
+	}
+}
+
+unsigned Rasterizer::GetWidth(){
+	return width;
+}
+
+unsigned Rasterizer::GetHeight(){
+	return height;
+}
+
+const vector<uint8_t>& Rasterizer::GetPixels(){
+	return pixels;
+}
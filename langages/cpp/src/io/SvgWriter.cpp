@@ -0,0 +1,119 @@
+#include "../../include/io/SvgWriter.h"
+
+#include <math.h>
+
+using namespace std;
+
+// Radius of the circle drawn for each node
+static const float RADIUS = SvgWriter::NODE_SIZE / 2.0f;
+
+void SvgWriter::WriteHeader(float minX, float minY, float maxX, float maxY){
+	// Nodes are squares from their position, with a margin for loops and labels
+	float left = minX - NODE_SIZE;
+	float top = minY - NODE_SIZE;
+	float width = maxX - minX + 3 * NODE_SIZE;
+	float height = maxY - minY + 3 * NODE_SIZE;
+	Write("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"");
+	WriteFloat(width);
+	Write("\" height=\"");
+	WriteFloat(height);
+	Write("\" viewBox=\"");
+	WriteFloat(left);
+	Write(" ");
+	WriteFloat(top);
+	Write(" ");
+	WriteFloat(width);
+	Write(" ");
+	WriteFloat(height);
+	Write("\">\n"
+		"<!--Created by LIEGE-->\n"
+		"<defs><marker id=\"arrow\" viewBox=\"0 0 10 10\" refX=\"10\" refY=\"5\" markerWidth=\"8\" markerHeight=\"8\" markerUnits=\"userSpaceOnUse\" orient=\"auto-start-reverse\"><path d=\"M0,0L10,5L0,10z\" fill=\"#000000\"/></marker></defs>\n");
+}
+
+void SvgWriter::WriteFooter(){
+	Write("</svg>\n");
+}
+
+void SvgWriter::BeginEdges(){
+	Write("<g stroke=\"#000000\" stroke-width=\"1\" fill=\"none\">\n");
+}
+
+void SvgWriter::BeginNodes(){
+	Write("<g fill=\"#FFCC00\" stroke=\"#000000\" stroke-width=\"1\">\n");
+}
+
+void SvgWriter::BeginLabels(){
+	Write("<g font-family=\"sans-serif\" font-size=\"12\" text-anchor=\"middle\" dominant-baseline=\"central\">\n");
+}
+
+void SvgWriter::EndGroup(){
+	Write("</g>\n");
+}
+
+void SvgWriter::WriteNode(float x, float y){
+	Write("<circle cx=\"");
+	WriteFloat(x + RADIUS);
+	Write("\" cy=\"");
+	WriteFloat(y + RADIUS);
+	Write("\" r=\"");
+	WriteFloat(RADIUS);
+	Write("\"/>\n");
+}
+
+void SvgWriter::WriteEdge(float fromX, float fromY, float toX, float toY, bool isBidirectional){
+	float dx = toX - fromX;
+	float dy = toY - fromY;
+	float length = sqrt(dx * dx + dy * dy);
+	// Loop : an arc from the top to the right of the node
+	if(length < 1e-3f){
+		Write("<path d=\"M");
+		WritePoint(fromX + RADIUS, fromY);
+		Write("A");
+		WritePoint(RADIUS * 0.8f, RADIUS * 0.8f);
+		Write(" 0 1,1 ");
+		WritePoint(fromX + NODE_SIZE, fromY + RADIUS);
+		Write("\" marker-end=\"url(#arrow)\"/>\n");
+		return;
+	}
+	// From border to border of the circles, so that arrows are visible
+	float trimX = dx * RADIUS / length;
+	float trimY = dy * RADIUS / length;
+	Write("<line x1=\"");
+	WriteFloat(fromX + RADIUS + trimX);
+	Write("\" y1=\"");
+	WriteFloat(fromY + RADIUS + trimY);
+	Write("\" x2=\"");
+	WriteFloat(toX + RADIUS - trimX);
+	Write("\" y2=\"");
+	WriteFloat(toY + RADIUS - trimY);
+	Write(isBidirectional ? "\" marker-start=\"url(#arrow)\" marker-end=\"url(#arrow)\"/>\n" : "\" marker-end=\"url(#arrow)\"/>\n");
+}
+
+void SvgWriter::WriteNodeLabel(float x, float y, string_view label){
+	WriteText(x + RADIUS, y + RADIUS, label);
+}
+
+void SvgWriter::WriteEdgeLabel(float fromX, float fromY, float toX, float toY, string_view label){
+	// Label of a loop : over its arc
+	if(fromX == toX && fromY == toY){
+		WriteText(fromX + NODE_SIZE, fromY - RADIUS / 2, label);
+		return;
+	}
+	WriteText((fromX + toX) / 2 + RADIUS, (fromY + toY) / 2 + RADIUS, label);
+}
+
+void SvgWriter::WritePoint(float x, float y){
+	WriteFloat(x);
+	Write(",");
+	WriteFloat(y);
+}
+
+void SvgWriter::WriteText(float x, float y, string_view label){
+	Write("<text x=\"");
+	WriteFloat(x);
+	Write("\" y=\"");
+	WriteFloat(y);
+	Write("\">");
+	WriteEscaped(label);
+	Write("</text>\n");
+}
@@ -0,0 +1,53 @@
+#include "../../include/io/WorkerPool.h"
+
+using namespace std;
+
+WorkerPool::WorkerPool(unsigned threadCount){
+	stopping = false;
+	if(threadCount == 0){
+		threadCount = max(1u, thread::hardware_concurrency());
+	}
+	for(unsigned t = 0; t < threadCount; t++){
+		workers.push_back(thread(&WorkerPool::Work, this));
+	}
+}
+
+WorkerPool::~WorkerPool(){
+	{
+		unique_lock<mutex> guard(lock);
+		stopping = true;
+	}
+	wakeUp.notify_all();
+	for(vector<thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker){
+		worker->join();
+	}
+}
+
+void WorkerPool::Submit(function<void()> task){
+	{
+		unique_lock<mutex> guard(lock);
+		tasks.push_back(move(task));
+	}
+	wakeUp.notify_one();
+}
+
+unsigned WorkerPool::GetThreadCount(){
+	return workers.size();
+}
+
+void WorkerPool::Work(){
+	while(true){
+		function<void()> task;			// Task taken from the queue
+		{
+			unique_lock<mutex> guard(lock);
+			wakeUp.wait(guard, [this](){return stopping || !tasks.empty();});
+			// Remaining tasks are run before stopping
+			if(tasks.empty()){
+				return;
+			}
+			task = move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
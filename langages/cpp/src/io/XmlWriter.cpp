@@ -0,0 +1,21 @@
+#include "../../include/io/XmlWriter.h"
+
+using namespace std;
+
+void XmlWriter::WriteEscaped(string_view text){
+	size_t begin = 0;
+	for(size_t i = 0; i < text.size(); i++){
+		const char* entity = NULL;
+		switch(text[i]){
+			case '&' : entity = "&amp;"; break;
+			case '<' : entity = "&lt;"; break;
+			case '>' : entity = "&gt;"; break;
+			case '"' : entity = "&quot;"; break;
+			default : continue;
+		}
+		Write(text.substr(begin, i - begin));
+		Write(entity);
+		begin = i + 1;
+	}
+	Write(text.substr(begin));
+}
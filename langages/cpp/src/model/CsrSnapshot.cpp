@@ -0,0 +1,165 @@
+#include "../../include/model/CsrSnapshot.h"
+
+using namespace std;
+
+CsrSnapshot::CsrSnapshot(){
+	offsets.push_back(0);
+	nodeLabelOffsets.push_back(0);
+	edgeLabelOffsets.push_back(0);
+}
+
+CsrSnapshot::CsrSnapshot(const vector<Node*>& nodes) : CsrSnapshot(nodes, function<bool(Edge*)>()){
+}
+
+CsrSnapshot::CsrSnapshot(const vector<Node*>& nodes, const function<bool(Edge*)>& keepEdge){
+	this->nodes = nodes;
+	// Nodes of a Graph-object already have a dense index : a dictionary is only needed for other lists of nodes
+	bool denseIndices = true;
+	for(size_t i = 0; i < nodes.size() && denseIndices; i++){
+		denseIndices = nodes[i]->GetIndex() == (int) i;
+	}
+	unordered_map<Node*, uint32_t> nodeToIndex;
+	if(!denseIndices){
+		nodeToIndex.reserve(nodes.size());
+		for(size_t i = 0; i < nodes.size(); i++){
+			nodeToIndex[nodes[i]] = i;
+		}
+	}
+	offsets.reserve(nodes.size() + 1);
+	nodeLabelOffsets.reserve(nodes.size() + 1);
+	coordinates.reserve(2 * nodes.size());
+	fixed.reserve(nodes.size());
+	offsets.push_back(0);
+	nodeLabelOffsets.push_back(0);
+	// Copy nodes : labels go to the pool, edges are flattened in node order
+	for(vector<Node*>::const_iterator node = nodes.begin(); node != nodes.end(); ++node){
+		labelPool += (*node)->GetName();
+		nodeLabelOffsets.push_back(labelPool.size());
+		bool isFixed = (*node)->IsFixedPos();
+		coordinates.push_back(isFixed ? (*node)->GetX() : 0);
+		coordinates.push_back(isFixed ? (*node)->GetY() : 0);
+		fixed.push_back(isFixed ? 1 : 0);
+		const vector<Edge*>& nodeEdges = (*node)->GetEdges();
+		for(vector<Edge*>::const_iterator edge = nodeEdges.begin(); edge != nodeEdges.end(); ++edge){
+			if(keepEdge && !keepEdge(*edge)){
+				continue;
+			}
+			Node* toNode = (*edge)->GetToNode();
+			int target = toNode->GetIndex();
+			if(denseIndices && (target < 0 || (size_t) target >= nodes.size() || nodes[target] != toNode)){
+				target = -1;
+			}
+			else if(!denseIndices){
+				unordered_map<Node*, uint32_t>::iterator found = nodeToIndex.find(toNode);
+				target = found == nodeToIndex.end() ? -1 : (int) found->second;
+			}
+			if(target < 0){
+				cout << "[WARNING] Edge \"" << (*edge)->GetName() << "\" goes to a node which is not in the snapshot ; this edge has been ignored" << endl;
+				continue;
+			}
+			targets.push_back(target);
+			weights.push_back((*edge)->GetWeight());
+			edges.push_back(*edge);
+		}
+		offsets.push_back(targets.size());
+	}
+	// Edge labels are stored after node labels in the same pool
+	edgeLabelOffsets.reserve(edges.size() + 1);
+	edgeLabelOffsets.push_back(labelPool.size());
+	for(vector<Edge*>::iterator edge = edges.begin(); edge != edges.end(); ++edge){
+		labelPool += (*edge)->GetName();
+		edgeLabelOffsets.push_back(labelPool.size());
+	}
+}
+
+CsrSnapshot::CsrSnapshot(size_t nodeCount, const vector<pair<uint32_t, uint32_t> >& edgeList, const vector<float>& coordinates) : CsrSnapshot(nodeCount, edgeList, coordinates, vector<string_view>(), vector<string_view>()){
+}
+
+CsrSnapshot::CsrSnapshot(size_t nodeCount, const vector<pair<uint32_t, uint32_t> >& edgeList, const vector<float>& coordinates, const vector<string_view>& nodeLabels, const vector<string_view>& edgeLabels){
+	size_t ignoredEdges = 0;			// Edges from or to a node index which does not exist
+	// Edges are grouped by source with a counting sort, which keeps their order
+	offsets.assign(nodeCount + 1, 0);
+	for(vector<pair<uint32_t, uint32_t> >::const_iterator edge = edgeList.begin(); edge != edgeList.end(); ++edge){
+		if(edge->first < nodeCount && edge->second < nodeCount){
+			offsets[edge->first + 1]++;
+		}
+		else{
+			ignoredEdges++;
+		}
+	}
+	for(size_t i = 0; i < nodeCount; i++){
+		offsets[i + 1] += offsets[i];
+	}
+	targets.resize(offsets[nodeCount]);
+	bool labelledEdges = edgeLabels.size() == edgeList.size();
+	if(!edgeLabels.empty() && !labelledEdges){
+		cout << "[WARNING] " << edgeLabels.size() << " labels given for " << edgeList.size() << " edges ; all edges are unlabelled" << endl;
+	}
+	vector<size_t> positions(labelledEdges ? targets.size() : 0);	// Position in the list of each edge of the snapshot, to find its label
+	vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+	for(size_t i = 0; i < edgeList.size(); i++){
+		if(edgeList[i].first < nodeCount && edgeList[i].second < nodeCount){
+			if(labelledEdges){
+				positions[next[edgeList[i].first]] = i;
+			}
+			targets[next[edgeList[i].first]++] = edgeList[i].second;
+		}
+	}
+	if(ignoredEdges > 0){
+		cout << "[WARNING] " << ignoredEdges << " edges go from or to a node index which is not lower than " << nodeCount << " ; these edges have been ignored" << endl;
+	}
+	weights.assign(targets.size(), 1);
+	nodeLabelOffsets.reserve(nodeCount + 1);
+	nodeLabelOffsets.push_back(0);
+	bool labelledNodes = nodeLabels.size() == nodeCount;
+	if(!nodeLabels.empty() && !labelledNodes){
+		cout << "[WARNING] " << nodeLabels.size() << " labels given for " << nodeCount << " nodes ; nodes are labelled with their index" << endl;
+	}
+	for(size_t i = 0; i < nodeCount; i++){
+		if(labelledNodes){
+			labelPool += nodeLabels[i];
+		}
+		else{
+			labelPool += to_string(i);
+		}
+		nodeLabelOffsets.push_back(labelPool.size());
+	}
+	if(!labelledEdges){
+		edgeLabelOffsets.assign(targets.size() + 1, labelPool.size());
+	}
+	else{
+		edgeLabelOffsets.reserve(targets.size() + 1);
+		edgeLabelOffsets.push_back(labelPool.size());
+		for(vector<size_t>::iterator position = positions.begin(); position != positions.end(); ++position){
+			labelPool += edgeLabels[*position];
+			edgeLabelOffsets.push_back(labelPool.size());
+		}
+	}
+	bool isFixed = coordinates.size() == 2 * nodeCount;
+	if(!coordinates.empty() && !isFixed){
+		cout << "[WARNING] " << coordinates.size() << " coordinates given for " << nodeCount << " nodes ; all nodes are free" << endl;
+	}
+	this->coordinates = isFixed ? coordinates : vector<float>(2 * nodeCount, 0);
+	fixed.assign(nodeCount, isFixed ? 1 : 0);
+}
+
+size_t CsrSnapshot::GetNodeCount() const{return offsets.size() - 1;}
+size_t CsrSnapshot::GetEdgeCount() const{return targets.size();}
+const vector<uint64_t>& CsrSnapshot::GetOffsets() const{return offsets;}
+const vector<uint32_t>& CsrSnapshot::GetTargets() const{return targets;}
+const vector<float>& CsrSnapshot::GetWeights() const{return weights;}
+const vector<uint64_t>& CsrSnapshot::GetNodeLabelOffsets() const{return nodeLabelOffsets;}
+const vector<uint64_t>& CsrSnapshot::GetEdgeLabelOffsets() const{return edgeLabelOffsets;}
+const string& CsrSnapshot::GetLabelPool() const{return labelPool;}
+const vector<float>& CsrSnapshot::GetCoordinates() const{return coordinates;}
+const vector<uint8_t>& CsrSnapshot::GetFixed() const{return fixed;}
+Node* CsrSnapshot::GetNode(size_t i) const{return i < nodes.size() ? nodes[i] : NULL;}
+Edge* CsrSnapshot::GetEdge(size_t i) const{return i < edges.size() ? edges[i] : NULL;}
+
+string CsrSnapshot::GetNodeLabel(size_t i) const{
+	return labelPool.substr(nodeLabelOffsets[i], nodeLabelOffsets[i + 1] - nodeLabelOffsets[i]);
+}
+
+string CsrSnapshot::GetEdgeLabel(size_t i) const{
+	return labelPool.substr(edgeLabelOffsets[i], edgeLabelOffsets[i + 1] - edgeLabelOffsets[i]);
+}
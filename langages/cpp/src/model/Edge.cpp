@@ -11,6 +11,7 @@ Edge::Edge(Node* fromNode, Node* toNode, string name){
 	this->fromNode = fromNode;
 	this->toNode = toNode;
 	this->name = name;
+	this->weight = 1;
 	this->isValid = true;
 	// This edge will not be valid if source node or target node is null
 	if(fromNode == NULL){
@@ -42,13 +43,25 @@ string Edge::ToString(bool printNodes){
 	return ss.str();
 }
 
-string Edge::ToDot(map<Node*, int> nodeToIndex){
+string Edge::ToDot(const map<Node*, int>& nodeToIndex){
+	// Unknown nodes get index 0, as before the dictionary was given by reference
+	map<Node*, int>::const_iterator fromIndex = nodeToIndex.find(fromNode);
+	map<Node*, int>::const_iterator toIndex = nodeToIndex.find(toNode);
 	stringstream ss;
-	ss << "\t" << nodeToIndex[fromNode] << " -> " << nodeToIndex[toNode] << " [label = \"" << name << "\"]";
+	ss << "\t" << (fromIndex == nodeToIndex.end() ? 0 : fromIndex->second) << " -> " << (toIndex == nodeToIndex.end() ? 0 : toIndex->second) << " [label = \"" << name << "\"]";
 	return ss.str();
 }
 
-string Edge::GetName(){return name;}
+const string& Edge::GetName(){return name;}
 Node* Edge::GetFromNode(){return fromNode;}
 Node* Edge::GetToNode(){return toNode;}
-bool Edge::IsValid(){return isValid;}
\ No newline at end of file
+float Edge::GetWeight(){return weight;}
+bool Edge::IsValid(){return isValid;}
+
+void Edge::SetWeight(float weight){
+	if(!(weight >= 0)){
+		cout << "[WARNING] A negative or undefined weight has been provided for edge \"" << name << "\" ; its weight has been kept" << endl;
+		return;
+	}
+	this->weight = weight;
+}
\ No newline at end of file
@@ -1,8 +1,92 @@
 #include "../../include/model/Graph.h"
+#include "../../include/model/GraphView.h"
+#include "../../include/algo/Betweenness.h"
+#include "../../include/algo/BreadthFirstSearch.h"
+#include "../../include/algo/ConnectedComponents.h"
+#include "../../include/algo/ShortestPath.h"
+#include "../../include/algo/TimingAnalysis.h"
+#include "../../include/algo/TopologicalOrder.h"
+#include "../../include/algo/ForceLayout.h"
+#include "../../include/algo/NodeOrder.h"
+#include "../../include/algo/PageRank.h"
+#include "../../include/io/BinaryFormat.h"
+#include "../../include/io/DotFormat.h"
+#include "../../include/io/DotWriter.h"
+#include "../../include/io/EdgeListFormat.h"
+#include "../../include/io/GraphmlWriter.h"
+#include "../../include/io/GraphvizRenderer.h"
+#include "../../include/io/PngFormat.h"
+#include "../../include/io/Rasterizer.h"
+#include "../../include/io/SvgWriter.h"
+#include "../../include/io/WorkerPool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <math.h>
+#include <mutex>
+#include <string.h>
+#include <sys/stat.h>
+#include <thread>
+#include <tuple>
 
 using namespace std;
 
+const size_t Graph::EXPORT_BLOCK_SIZE;
+
+// Files being written by an export of any graph : two exports must not write the same file at once
+static mutex writtenPathsLock;
+static condition_variable writtenPathsReleased;
+static set<string> writtenPaths;
+
+// Reserve the files of an export, waiting for the exports writing them or giving up (the busy file is then given)
+static bool ReservePaths(const vector<string>& paths, bool wait, string& busyPath){
+	unique_lock<mutex> lock(writtenPathsLock);
+	auto arePathsFree = [&paths, &busyPath](){
+		for(vector<string>::const_iterator path = paths.begin(); path != paths.end(); ++path){
+			if(!path->empty() && writtenPaths.count(*path) > 0){
+				busyPath = *path;
+				return false;
+			}
+		}
+		return true;
+	};
+	if(wait){
+		writtenPathsReleased.wait(lock, arePathsFree);
+	}
+	else if(!arePathsFree()){
+		return false;
+	}
+	for(vector<string>::const_iterator path = paths.begin(); path != paths.end(); ++path){
+		if(!path->empty()){
+			writtenPaths.insert(*path);
+		}
+	}
+	return true;
+}
+
+// Release the files of an export
+static void ReleasePaths(const vector<string>& paths){
+	{
+		lock_guard<mutex> lock(writtenPathsLock);
+		for(vector<string>::const_iterator path = paths.begin(); path != paths.end(); ++path){
+			writtenPaths.erase(*path);
+		}
+	}
+	writtenPathsReleased.notify_all();
+}
+
 Graph::Graph(){
+	exportThreads = 1;
+	importThreads = 0;
+	nativeRendering = false;
+	compactDot = false;
+	nextSerial = 0;
+	structureHash = 0;
+	exportHash = 0;
+	exportTicket = 0;
+	recordedTicket = 0;
+	asyncExport = make_shared<AsyncExportRecord>();
+	asyncExport->ticket = 0;
 	Clear();
 }
 
@@ -11,27 +95,55 @@ Graph::~Graph(){
 }
 
 void Graph::Clear(){
-	// Clearing list of nodes calls destruction of the nodes, but we have to call manually shrink to reduce memory used by the empty list
+	// Edges between two nodes of this graph are deleted at once : they are first forgotten by their target, then deleted by their source
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		vector<Edge*>& incomingEdges = (*node)->incomingEdges;
+		incomingEdges.erase(remove_if(incomingEdges.begin(), incomingEdges.end(), [this](Edge* edge){return Contains(edge->GetFromNode());}), incomingEdges.end());
+	}
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		vector<Edge*>& edges = (*node)->edges;
+		edges.erase(remove_if(edges.begin(), edges.end(), [this](Edge* edge){
+			if(!Contains(edge->GetToNode())){
+				return false;
+			}
+			delete edge;
+			return true;
+		}), edges.end());
+		// Nodes do not log their changes here anymore
+		(*node)->changeLog = NULL;
+		(*node)->changed = false;
+	}
+	// Nodes are created in Graph context. They have to be deleted here : only edges from or to nodes of other graphs remain for their destructor.
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		delete *node;
+	}
+	// We have to call manually shrink to reduce memory used by the empty list
 	nodes.clear();
 	nodes.shrink_to_fit();
+	graphmlIdToNode.clear();
+	nodeToGraphmlId.clear();
+	changedNodes.clear();
+	structureHash = 0;
+	unpatchedNodes.clear();
+	deletedSerials.clear();
+	dotPatch.Forget();
+	spatialIndex.Clear();
+	exportHash = 0;
+	exportedFiles.clear();
+	// Asynchronous exports still running describe the graph before it has been cleared
+	recordedTicket = exportTicket;
 }
 
 Node* Graph::CreateNode(){
-	Node* newNode = new Node();
-	nodes.push_back(newNode);
-	return newNode;
+	return AddNode(new Node());
 }
 
 Node* Graph::CreateNode(string name){
-	Node* newNode = new Node(name);
-	nodes.push_back(newNode);
-	return newNode;
+	return AddNode(new Node(name));
 }
 
 Node* Graph::CreateNode(string name, float x, float y){
-	Node* newNode = new Node(name, x, y);
-	nodes.push_back(newNode);
-	return newNode;
+	return AddNode(new Node(name, x, y));
 }
 
 vector<Edge*> Graph::ConnectNodes(Node* fromNode, Node* toNode){
@@ -55,14 +167,35 @@ void Graph::DeleteNode(Node* node){
 		cout << "[WARNING] Trying to delete a null node ; it has been ignored" << endl;
 		return;
 	}
-	vector<Node*>::iterator nodeInCollection = find(nodes.begin(), nodes.end(), node);
-	if(nodeInCollection == nodes.end()){
+	if(!Contains(node)){
 		cout << "[WARNING] Trying to delete node \"" << node->GetName() << "\" which is not in graph collection ; this node has not been removed" << endl;
 		return;
 	}
+	int index = node->index;
+	// The node leaves the log of changed nodes and the structural hash, and its block will be erased by next PatchDot
+	if(node->changed){
+		changedNodes.erase(find(changedNodes.begin(), changedNodes.end(), node));
+	}
+	node->changeLog = NULL;
+	structureHash -= node->hash;
+	unpatchedNodes.erase(node);
+	spatialIndex.Remove(node);
+	if(dotPatch.IsStarted()){
+		deletedSerials.push_back(node->serial);
+	}
+	// Forget its unique index from GraphML while the node still exists
+	unordered_map<Node*, string>::iterator graphmlId = nodeToGraphmlId.find(node);
+	if(graphmlId != nodeToGraphmlId.end()){
+		graphmlIdToNode.erase(graphmlId->second);
+		nodeToGraphmlId.erase(graphmlId);
+	}
 	// Nodes are created in Graph context. They have to be deleted here. Deletion call destruction of the node, which call the destruction of all edges from and to this node.
 	delete node;
-	nodes.erase(nodeInCollection);
+	nodes.erase(nodes.begin() + index);
+	// Following nodes move back by one place
+	for(size_t i = index; i < nodes.size(); i++){
+		nodes[i]->index = i;
+	}
 }
 
 void Graph::DeleteEdge(Edge* edge){
@@ -87,101 +220,639 @@ vector<Node*> Graph::GetNodes(){
 	return nodes;
 }
 
-void Graph::ExportDot(string pathDot){
-	ExportDot(pathDot, "", "");
+void Graph::SetExportThreads(unsigned threadCount){
+	exportThreads = threadCount;
+}
+
+void Graph::SetImportThreads(unsigned threadCount){
+	importThreads = threadCount;
+}
+
+void Graph::SetNativeRendering(bool enabled){
+	nativeRendering = enabled;
 }
 
-void Graph::ExportDot(string pathDot, string pathPng){
-	ExportDot(pathDot, pathPng, "");
+void Graph::SetCompactDot(bool enabled){
+	compactDot = enabled;
 }
 
-void Graph::ExportDot(string pathDot, string pathPng, string pathSvg){
-	ExportDot(pathDot, pathPng, pathSvg, 0);
+bool Graph::ExportDot(string pathDot){
+	return ExportDot(pathDot, "", "");
 }
 
-void Graph::ExportDot(string pathDot, float scale){
-	ExportDot(pathDot, "", "", scale);
+bool Graph::ExportDot(string pathDot, string pathPng){
+	return ExportDot(pathDot, pathPng, "");
+}
+
+bool Graph::ExportDot(string pathDot, string pathPng, string pathSvg){
+	return ExportDot(pathDot, pathPng, pathSvg, 0);
+}
+
+bool Graph::ExportDot(string pathDot, float scale){
+	return ExportDot(pathDot, "", "", scale);
+}
+
+bool Graph::ExportDot(string pathDot, string pathPng, float scale){
+	return ExportDot(pathDot, pathPng, "", scale);
+}
+
+unsigned long long Graph::GetStructureHash(){
+	ApplyChanges();
+	return structureHash;
+}
+
+bool Graph::ExportDot(string pathDot, string pathPng, string pathSvg, float scale){
+	vector<string> paths = {pathDot, pathPng, pathSvg};	// Files to write
+	unsigned long long hash = HashExport(paths, scale);	// Hash of the graph and of the parameters
+	string busyPath;				// File written by another export
+	// Asynchronous exports of the same files are finished first, so their result is known
+	ReservePaths(paths, true, busyPath);
+	// Same graph and same parameters : files are up to date if nobody has modified them
+	if(IsExportUpToDate(hash, paths)){
+		ReleasePaths(paths);
+		return true;
+	}
+	exportHash = 0;
+	recordedTicket = ++exportTicket;
+	bool success = WriteDotExport(pathDot, pathPng, pathSvg, scale);
+	if(success && FindExportedFiles(paths, exportedFiles)){
+		exportHash = hash;
+	}
+	ReleasePaths(paths);
+	return success;
 }
 
-void Graph::ExportDot(string pathDot, string pathPng, float scale){
-	ExportDot(pathDot, pathPng, "", scale);
+bool Graph::ExportDot(GraphView& view, string pathDot){
+	return ExportDot(view, pathDot, 0);
 }
 
-void Graph::ExportDot(string pathDot, string pathPng, string pathSvg, float scale){
-	map<Node*, vector<Edge*> > nodeToEdges;		// Discovered edges for each node
-	map<Node*, int> nodeToIndex;			// Unique index for each node
-	int i = 0;					// Unique index to increment
+bool Graph::ExportDot(GraphView& view, string pathDot, float scale){
+	if(&view.GetGraph() != this){
+		cout << "[ERROR] Trying to export a view of another graph ; the view has not been exported" << endl;
+		return false;
+	}
+	vector<string> paths = {pathDot};		// File to write
+	string busyPath;				// File written by another export
+	// Asynchronous exports of the same file are finished first, so they do not write it at the same time
+	ReservePaths(paths, true, busyPath);
+	bool success = WriteDotView(view, pathDot, scale);
+	ReleasePaths(paths);
+	return success;
+}
+
+bool Graph::WriteDotView(GraphView& view, string pathDot, float scale){
+	DotWriter fichier;				// DOT file to write
+	if(!fichier.Open(pathDot)){
+		cout << "[ERROR] Failed to open DOT file \"" << pathDot << "\" ; the view has not been exported" << endl;
+		return false;
+	}
+	fichier.WriteHeader();
+	// Nodes keep their index in the whole graph : edges need no dictionary of the nodes of the view
+	vector<Node*> viewNodes = view.GetNodes();
+	vector<Edge*> viewEdges;			// Edges of the view, in order of nodes then of their outgoing edges
+	for(vector<Node*>::iterator node = viewNodes.begin(); node != viewNodes.end(); ++node){
+		view.VisitEdges(*node, [&viewEdges](Edge* edge){
+			viewEdges.push_back(edge);
+		});
+	}
+	// Compact text : reciprocal edges of the view are paired, like in the export of the whole graph
+	DotCompaction compaction;
+	if(compactDot){
+		compaction.pairedEdges = FindReverseEdges(viewEdges);
+		ChooseEdgeDefaults(viewEdges, compaction);
+		fichier.WriteEdgeDefaults(compaction.bidirectionalByDefault ? "both" : "", !compaction.label.empty(), compaction.label);
+	}
+	for(vector<Node*>::iterator node = viewNodes.begin(); node != viewNodes.end(); ++node){
+		if(compactDot){
+			fichier.WriteCompactNode((*node)->index, (*node)->name, (*node)->fixedPos, (*node)->x, (*node)->y, scale);
+		}
+		else{
+			fichier.WriteNode((*node)->index, (*node)->name, (*node)->fixedPos, (*node)->x, (*node)->y, scale);
+		}
+	}
+	for(size_t sequence = 0; sequence < viewEdges.size(); sequence++){
+		Edge* edge = viewEdges[sequence];
+		int fromIndex = edge->GetFromNode()->index;
+		int toIndex = edge->GetToNode()->index;
+		if(!compactDot){
+			fichier.WriteEdge(fromIndex, toIndex, edge->GetName());
+			continue;
+		}
+		bool isBidirectional = compaction.pairedEdges[sequence];
+		// The edge of the pair with the greatest source index is written with the other one
+		if(isBidirectional && toIndex < fromIndex){
+			continue;
+		}
+		string_view dir = isBidirectional == compaction.bidirectionalByDefault ? "" : (isBidirectional ? "both" : "forward");
+		fichier.WriteCompactEdge(fromIndex, toIndex, dir, edge->GetName() != compaction.label, edge->GetName());
+	}
+	fichier.WriteFooter();
+	if(!fichier.Close()){
+		cout << "[ERROR] Failed to write DOT file \"" << pathDot << "\" ; the exported view is incomplete" << endl;
+		return false;
+	}
+	return true;
+}
+
+future<bool> Graph::ExportDotAsync(string pathDot, string pathPng, string pathSvg){
+	return ExportDotAsync(pathDot, pathPng, pathSvg, 0);
+}
+
+future<bool> Graph::ExportDotAsync(string pathDot, string pathPng, string pathSvg, float scale){
+	vector<string> paths = {pathDot, pathPng, pathSvg};	// Files to write
+	unsigned long long hash = HashExport(paths, scale);	// Hash of the graph and of the parameters
+	promise<bool> immediate;			// Result known without starting the export
+	string busyPath;				// File written by another export
+	// Files are reserved before they are checked, so no other export can change them in between
+	if(!ReservePaths(paths, false, busyPath)){
+		cout << "[ERROR] Another export is writing \"" << busyPath << "\" ; the graph has not been exported" << endl;
+		immediate.set_value(false);
+		return immediate.get_future();
+	}
+	if(IsExportUpToDate(hash, paths)){
+		ReleasePaths(paths);
+		immediate.set_value(true);
+		return immediate.get_future();
+	}
+	// The files are rewritten : only this export or a later one may record them again
+	exportHash = 0;
+	recordedTicket = exportTicket;
+	// The snapshot is taken now : later changes of the graph do not reach this export
+	shared_ptr<CsrSnapshot> snapshot = make_shared<CsrSnapshot>(Freeze());
+	unsigned long long ticket = ++exportTicket;
+	shared_ptr<AsyncExportRecord> record = asyncExport;
+	unsigned threadCount = exportThreads;
+	bool native = nativeRendering;
+	bool compact = compactDot;
+	shared_ptr<packaged_task<bool()> > task = make_shared<packaged_task<bool()> >([snapshot, paths, scale, threadCount, native, compact, hash, ticket, record](){
+		// Nodes of the copy have the same dense indexes, so the files are the same as the ones of the original graph
+		Graph copy;
+		copy.SetExportThreads(threadCount);
+		copy.SetNativeRendering(native);
+		copy.SetCompactDot(compact);
+		copy.Thaw(*snapshot);
+		bool success = copy.WriteDotExport(paths[0], paths[1], paths[2], scale);
+		// The written files are recorded before they are released, so the next export of the same files finds them
+		vector<ExportedFile> files;
+		if(success && FindExportedFiles(paths, files)){
+			lock_guard<mutex> lock(record->lock);
+			if(ticket > record->ticket){
+				record->ticket = ticket;
+				record->hash = hash;
+				record->files.swap(files);
+			}
+		}
+		ReleasePaths(paths);
+		return success;
+	});
+	future<bool> result = task->get_future();
+	GetExportPool().Submit([task](){(*task)();});
+	return result;
+}
+
+bool Graph::WriteDotExport(string pathDot, string pathPng, string pathSvg, float scale){
 	bool fixedPos = false;				// If any node has a fixed position
-	ofstream fichier(pathDot);			// DOT file to write
-	fichier << "digraph LIEGE{" << endl;		// DOT header. TODO : add metadata for nodes and edges
-	// Iterate over the nodes ...
+	size_t ignoredEdges = 0;			// Edges going to a node which is not in this graph
+	DotWriter fichier;				// DOT file to write
+	GraphvizRenderer renderer;			// Graphviz run drawing the images
+	bool allFixed = !nodes.empty();			// If all nodes have a fixed position
+	// If any node is fixed, all the graph will be fixed
 	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
-		// Grab DOT text for this node
-		fichier << (*node)->ToDot(i, scale) << endl;
-		// If this node is fixed, all the graph will be fixed
-		fixedPos = fixedPos || (*node)->IsFixedPos();
-		// Discover all edges from this node
-		nodeToEdges[*node] = (*node)->GetEdges();
-		// Give the unique index to this node
-		nodeToIndex[*node] = i++;
-	}
-	// ... and iterate over the discovered edges for each node
-	for(map<Node*, vector<Edge*> >::iterator node = nodeToEdges.begin(); node != nodeToEdges.end(); ++node){
-		for(vector<Edge*>::iterator edge = node->second.begin(); edge != node->second.end(); ++edge){
-			// Grab DOT text for this edge
-			fichier << (*edge)->ToDot(nodeToIndex) << endl;
+		fixedPos = fixedPos || (*node)->fixedPos;
+		allFixed = allFixed && (*node)->fixedPos;
+	}
+	// Native rendering : images of a positioned graph are drawn without Graphviz
+	if(nativeRendering && allFixed && (!pathPng.empty() || !pathSvg.empty())){
+		bool success = pathDot.empty() || WriteDotExport(pathDot, "", "", scale);
+		if(!pathPng.empty()){
+			success = ExportPng(pathPng) && success;
+		}
+		if(!pathSvg.empty()){
+			success = ExportSvg(pathSvg) && success;
+		}
+		return success;
+	}
+	if(fixedPos){
+		renderer.SetEngine("fdp");
+	}
+	// All images are drawn by one Graphviz run
+	if(!pathPng.empty()){
+		renderer.AddOutput("png", pathPng);
+	}
+	if(!pathSvg.empty()){
+		renderer.AddOutput("svg", pathSvg);
+	}
+	if(pathDot.empty() && !renderer.HasOutputs()){
+		cout << "[ERROR] No DOT file nor image to export" << endl;
+		return false;
+	}
+	// Without DOT file, DOT text is streamed to Graphviz
+	if(pathDot.empty()){
+		if(!renderer.Start("")){
+			cout << "[ERROR] " << renderer.GetErrors() << " ; the graph has not been drawn" << endl;
+			return false;
 		}
+		fichier.Attach(renderer.GetInput());
+	}
+	else if(!fichier.Open(pathDot)){
+		cout << "[ERROR] Failed to open DOT file \"" << pathDot << "\" ; the graph has not been exported" << endl;
+		return false;
+	}
+	fichier.WriteHeader();				// DOT header. TODO : add metadata for nodes and edges
+	// Compact text : reciprocal edges are paired, and the most frequent attributes of edges are written once
+	DotCompaction compaction;
+	if(compactDot){
+		PrepareCompaction(compaction);
+		fichier.WriteEdgeDefaults(compaction.bidirectionalByDefault ? "both" : "", !compaction.label.empty(), compaction.label);
+	}
+	// Write all nodes, then all edges
+	WriteDotSection(fichier, false, scale, compactDot ? &compaction : NULL, ignoredEdges);
+	WriteDotSection(fichier, true, scale, compactDot ? &compaction : NULL, ignoredEdges);
+	if(ignoredEdges > 0){
+		cout << "[WARNING] " << ignoredEdges << " edges go to a node which is not in graph collection ; these edges have not been exported" << endl;
 	}
 	// DOT footer and close
-	fichier << "}" << endl;
-	fichier.close();
-	stringstream ss;
-	// Generate PNG file if path is given
-	if(!pathPng.empty()){ //TODO : verif si le chemin est possible
-		ss << "dot ";
-		if(fixedPos){
-			ss << "-Kfdp ";
+	fichier.WriteFooter();
+	bool written = fichier.Close();
+	if(!written && !pathDot.empty()){
+		cout << "[ERROR] Failed to write DOT file \"" << pathDot << "\" ; the exported graph is incomplete" << endl;
+		return false;
+	}
+	if(!renderer.HasOutputs()){
+		return true;
+	}
+	// Draw images from the DOT file if it has been written
+	if(!pathDot.empty() && !renderer.Start(pathDot)){
+		cout << "[ERROR] " << renderer.GetErrors() << " ; the graph has not been drawn" << endl;
+		return false;
+	}
+	if(!renderer.Wait()){
+		cout << "[ERROR] Graphviz failed with exit status " << renderer.GetExitStatus() << " ; images may be missing or incomplete" << endl;
+		if(!renderer.GetErrors().empty()){
+			cout << renderer.GetErrors() << endl;
 		}
-		ss << "-Tpng " << pathDot << " > " << pathPng;
-		system(ss.str().c_str());
+		return false;
+	}
+	if(!renderer.GetErrors().empty()){
+		cout << "[WARNING] Graphviz : " << renderer.GetErrors() << endl;
 	}
-	// Generate SVG file if path is given
-	ss.str(string());
-	if(!pathSvg.empty()){ //idem
-		ss << "dot ";
-		if(fixedPos){
-			ss << "-Kfdp ";
+	if(!written){
+		cout << "[ERROR] Failed to stream DOT text to Graphviz ; images may be incomplete" << endl;
+		return false;
+	}
+	return true;
+}
+
+bool Graph::PatchDot(string pathDot){
+	return PatchDot(pathDot, 0);
+}
+
+bool Graph::PatchDot(string pathDot, float scale){
+	DotWriter block;				// Text of the block of a node
+	size_t ignoredEdges = 0;			// Edges going to a node which is not in this graph
+	vector<Node*> written;				// Nodes whose block is written
+	ApplyChanges();
+	bool patched = dotPatch.Resume(pathDot, scale);	// If only changed nodes are written
+	if(!patched && !dotPatch.Create(pathDot, scale)){
+		cout << "[ERROR] Failed to open DOT file \"" << pathDot << "\" ; the graph has not been exported" << endl;
+		return false;
+	}
+	if(patched){
+		for(vector<long long>::iterator serial = deletedSerials.begin(); serial != deletedSerials.end(); ++serial){
+			dotPatch.EraseBlock(*serial);
+		}
+		// Changed blocks are written in creation order, so the file does not depend on hashing of pointers
+		written.assign(unpatchedNodes.begin(), unpatchedNodes.end());
+		sort(written.begin(), written.end(), [](Node* a, Node* b){return a->serial < b->serial;});
+	}
+	// Without a previous file, all nodes are written
+	vector<Node*>& blocks = patched ? written : nodes;
+	for(vector<Node*>::iterator node = blocks.begin(); node != blocks.end(); ++node){
+		ignoredEdges += WriteDotBlock(block, *node, scale);
+		dotPatch.WriteBlock((*node)->serial, string_view(block.GetData(), block.GetSize()));
+		block.Reset();
+	}
+	// The file is up to date
+	unpatchedNodes.clear();
+	deletedSerials.clear();
+	if(ignoredEdges > 0){
+		cout << "[WARNING] " << ignoredEdges << " edges go to a node which is not in graph collection ; these edges have not been exported" << endl;
+	}
+	if(!dotPatch.Finish()){
+		cout << "[ERROR] Failed to write DOT file \"" << pathDot << "\" ; it will be written again by next patch" << endl;
+		return false;
+	}
+	return true;
+}
+
+void Graph::ExportGraphml(string path){
+	GraphmlWriter fichier;				// GraphML file to write
+	if(!fichier.Open(path)){
+		cout << "[ERROR] Failed to open GraphML file \"" << path << "\" ; the graph has not been exported" << endl;
+		return;
+	}
+	fichier.WriteHeader();
+	// Free nodes are put on a grid : yEd needs a position for every node
+	size_t columns = max((size_t) 1, (size_t) ceil(sqrt((double) nodes.size())));
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		size_t i = (*node)->index;
+		if((*node)->fixedPos){
+			fichier.WriteNode(i, (*node)->name, (*node)->x, (*node)->y);
+		}
+		else{
+			fichier.WriteNode(i, (*node)->name, (i % columns) * 2 * GraphmlWriter::NODE_SIZE, (i / columns) * 2 * GraphmlWriter::NODE_SIZE);
+		}
+	}
+	// Reciprocal edges with the same label are written once with an arrow on both sides, like yEd bidirectional edges
+	vector<bool> pairedEdges = FindReverseEdges();
+	size_t edgeIndex = 0;
+	size_t ignoredEdges = 0;
+	size_t sequence = 0;
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		for(vector<Edge*>::iterator edge = (*node)->edges.begin(); edge != (*node)->edges.end(); ++edge, ++sequence){
+			Node* toNode = (*edge)->GetToNode();
+			if(!Contains(toNode)){
+				ignoredEdges++;
+				continue;
+			}
+			bool isBidirectional = pairedEdges[sequence];
+			// The edge of the pair with the greatest source index has already been written with the other one
+			if(isBidirectional && toNode->index < (*node)->index){
+				continue;
+			}
+			fichier.WriteEdge(edgeIndex++, (*node)->index, toNode->index, (*edge)->GetName(), isBidirectional);
 		}
-		ss << "-Tsvg " << pathDot << " > " << pathSvg;
-		system(ss.str().c_str());
+	}
+	if(ignoredEdges > 0){
+		cout << "[WARNING] " << ignoredEdges << " edges go to a node which is not in graph collection ; these edges have not been exported" << endl;
+	}
+	fichier.WriteFooter();
+	if(!fichier.Close()){
+		cout << "[ERROR] Failed to write GraphML file \"" << path << "\" ; the exported graph is incomplete" << endl;
 	}
 }
 
+bool Graph::ExportSvg(string path){
+	float minX, minY, maxX, maxY;			// Bounds of drawn nodes
+	size_t ignoredEdges = 0;			// Edges going to a node which is not in this graph
+	FindDrawingBounds(minX, minY, maxX, maxY);
+	SvgWriter fichier;				// SVG file to write
+	if(!fichier.Open(path)){
+		cout << "[ERROR] Failed to open SVG file \"" << path << "\" ; the graph has not been exported" << endl;
+		return false;
+	}
+	fichier.WriteHeader(minX, minY, maxX, maxY);
+	// Edges under nodes, labels over everything
+	vector<bool> pairedEdges = FindReverseEdges();
+	fichier.BeginEdges();
+	VisitDrawnEdges(pairedEdges, ignoredEdges, [&fichier](Node* fromNode, Node* toNode, Edge*, bool isBidirectional){
+		fichier.WriteEdge(fromNode->x, fromNode->y, toNode->x, toNode->y, isBidirectional);
+	});
+	fichier.EndGroup();
+	fichier.BeginNodes();
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		if((*node)->fixedPos){
+			fichier.WriteNode((*node)->x, (*node)->y);
+		}
+	}
+	fichier.EndGroup();
+	fichier.BeginLabels();
+	size_t ignoredLabels = 0;			// Already counted with edges
+	VisitDrawnEdges(pairedEdges, ignoredLabels, [&fichier](Node* fromNode, Node* toNode, Edge* edge, bool){
+		if(!edge->GetName().empty()){
+			fichier.WriteEdgeLabel(fromNode->x, fromNode->y, toNode->x, toNode->y, edge->GetName());
+		}
+	});
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		if((*node)->fixedPos && !(*node)->name.empty()){
+			fichier.WriteNodeLabel((*node)->x, (*node)->y, (*node)->name);
+		}
+	}
+	fichier.EndGroup();
+	if(ignoredEdges > 0){
+		cout << "[WARNING] " << ignoredEdges << " edges go to a node which is not in graph collection ; these edges have not been exported" << endl;
+	}
+	fichier.WriteFooter();
+	if(!fichier.Close()){
+		cout << "[ERROR] Failed to write SVG file \"" << path << "\" ; the drawing is incomplete" << endl;
+		return false;
+	}
+	return true;
+}
+
+bool Graph::ExportPng(string path){
+	return ExportPng(path, 4096);
+}
+
+bool Graph::ExportPng(string path, unsigned maxSize){
+	float minX, minY, maxX, maxY;			// Bounds of drawn nodes
+	size_t ignoredEdges = 0;			// Edges going to a node which is not in this graph
+	FindDrawingBounds(minX, minY, maxX, maxY);
+	// Same frame as ExportSvg (1 pixel per unit), reduced to fit in the maximum size
+	const float nodeSize = SvgWriter::NODE_SIZE;
+	float frameWidth = maxX - minX + 3 * nodeSize;
+	float frameHeight = maxY - minY + 3 * nodeSize;
+	float scale = min(1.0f, maxSize / max(frameWidth, frameHeight));
+	float originX = minX - nodeSize;
+	float originY = minY - nodeSize;
+	float radius = nodeSize / 2 * scale;
+	Rasterizer image(max(1u, (unsigned) ceil(frameWidth * scale)), max(1u, (unsigned) ceil(frameHeight * scale)), 0xFFFFFF);
+	image.SetThreads(exportThreads);
+	// Edges under nodes
+	vector<bool> pairedEdges = FindReverseEdges();
+	VisitDrawnEdges(pairedEdges, ignoredEdges, [&](Node* fromNode, Node* toNode, Edge*, bool isBidirectional){
+		float fromX = (fromNode->x - originX) * scale + radius;
+		float fromY = (fromNode->y - originY) * scale + radius;
+		image.DrawArrow(fromX, fromY, (toNode->x - originX) * scale + radius, (toNode->y - originY) * scale + radius, radius, 8 * scale, isBidirectional, 0x000000);
+	});
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		if((*node)->fixedPos){
+			image.DrawCircle(((*node)->x - originX) * scale + radius, ((*node)->y - originY) * scale + radius, radius, 0xFFCC00, 0x000000);
+		}
+	}
+	if(ignoredEdges > 0){
+		cout << "[WARNING] " << ignoredEdges << " edges go to a node which is not in graph collection ; these edges have not been exported" << endl;
+	}
+	image.Render();
+	if(!PngFormat::Save(image.GetPixels(), image.GetWidth(), image.GetHeight(), path)){
+		cout << "[ERROR] Failed to write PNG file \"" << path << "\" ; the graph has not been drawn" << endl;
+		return false;
+	}
+	return true;
+}
+
 void Graph::ImportGraphml(string path){
-	map<string, Node*> iToNode;	// Dictionary of found nodes, key is unique index from GraphML
+	vector<GraphmlNode> xmlNodes;
+	vector<GraphmlEdge> xmlEdges;
+	if(!ReadGraphml(path, xmlNodes, xmlEdges)){
+		return;
+	}
+	map<string, Node*> iToNode;	// Dictionary of created nodes, key is unique index from GraphML
+	// Create the nodes, put them in the dictionary and remember their unique index for later merges
+	for(vector<GraphmlNode>::iterator xmlNode = xmlNodes.begin(); xmlNode != xmlNodes.end(); ++xmlNode){
+		Node* node = CreateNode(xmlNode->name, xmlNode->x, xmlNode->y);
+		iToNode[xmlNode->id] = node;
+		IndexGraphmlId(node, xmlNode->id);
+	}
+	// Create the edges between these nodes
+	for(vector<GraphmlEdge>::iterator xmlEdge = xmlEdges.begin(); xmlEdge != xmlEdges.end(); ++xmlEdge){
+		ConnectNodes(iToNode[xmlEdge->source], iToNode[xmlEdge->target], xmlEdge->isBidirectional, xmlEdge->name);
+	}
+}
+
+GraphDelta Graph::MergeGraphml(string path){
+	return MergeGraphml(path, false, true);
+}
+
+GraphDelta Graph::MergeGraphml(string path, bool matchByLabel, bool removeMissing){
+	GraphDelta delta;
+	vector<GraphmlNode> xmlNodes;
+	vector<GraphmlEdge> xmlEdges;
+	if(!ReadGraphml(path, xmlNodes, xmlEdges)){
+		return delta;
+	}
+	// Nodes which can still be matched by their label (first node for each label)
+	map<string, Node*> nameToNode;
+	for(vector<Node*>::reverse_iterator node = nodes.rbegin(); node != nodes.rend(); ++node){
+		nameToNode[(*node)->GetName()] = *node;
+	}
+	map<string, Node*> iToNode;	// Dictionary of matched or created nodes, key is unique index from this GraphML file
+	set<Node*> matchedNodes;	// Nodes which are in this GraphML file
+	for(vector<GraphmlNode>::iterator xmlNode = xmlNodes.begin(); xmlNode != xmlNodes.end(); ++xmlNode){
+		Node* node = NULL;
+		// Match by unique index from a previous import, then by label
+		if(!matchByLabel){
+			unordered_map<string, Node*>::iterator known = graphmlIdToNode.find(xmlNode->id);
+			if(known != graphmlIdToNode.end() && matchedNodes.count(known->second) == 0){
+				node = known->second;
+			}
+		}
+		if(node == NULL){
+			map<string, Node*>::iterator sameName = nameToNode.find(xmlNode->name);
+			if(sameName != nameToNode.end() && matchedNodes.count(sameName->second) == 0){
+				node = sameName->second;
+			}
+		}
+		// Update only what has changed
+		if(node == NULL){
+			node = CreateNode(xmlNode->name, xmlNode->x, xmlNode->y);
+			delta.addedNodes.push_back(node);
+			IndexGraphmlId(node, xmlNode->id);
+		}
+		else{
+			if(node->GetName() != xmlNode->name){
+				node->SetName(xmlNode->name);
+				delta.renamedNodes.push_back(node);
+			}
+			if(!node->IsFixedPos() || node->GetX() != xmlNode->x || node->GetY() != xmlNode->y){
+				node->SetPos(xmlNode->x, xmlNode->y);
+				delta.movedNodes.push_back(node);
+			}
+		}
+		nameToNode.erase(node->GetName());
+		matchedNodes.insert(node);
+		iToNode[xmlNode->id] = node;
+		// A node created by code gets no unique index : it must not be removed when a next file misses it
+		if(nodeToGraphmlId.count(node) != 0){
+			IndexGraphmlId(node, xmlNode->id);
+		}
+	}
+	// Nodes coming from a previous import but missing in this file are removed (nodes created by code are kept)
+	if(removeMissing){
+		vector<Node*> missingNodes;
+		for(unordered_map<Node*, string>::iterator indexed = nodeToGraphmlId.begin(); indexed != nodeToGraphmlId.end(); ++indexed){
+			if(matchedNodes.count(indexed->first) == 0){
+				missingNodes.push_back(indexed->first);
+			}
+		}
+		for(vector<Node*>::iterator node = missingNodes.begin(); node != missingNodes.end(); ++node){
+			delta.removedNodes.push_back((*node)->GetName());
+			DeleteNode(*node);
+		}
+	}
+	// Wanted edges between nodes of this file, by source, target and label
+	map<tuple<Node*, Node*, string>, int> wantedEdges;
+	for(vector<GraphmlEdge>::iterator xmlEdge = xmlEdges.begin(); xmlEdge != xmlEdges.end(); ++xmlEdge){
+		Node* source = iToNode[xmlEdge->source];
+		Node* target = iToNode[xmlEdge->target];
+		wantedEdges[make_tuple(source, target, xmlEdge->name)]++;
+		if(xmlEdge->isBidirectional){
+			wantedEdges[make_tuple(target, source, xmlEdge->name)]++;
+		}
+	}
+	// Keep existing edges which are still wanted, delete the other ones between imported nodes of this file
+	for(set<Node*>::iterator node = matchedNodes.begin(); node != matchedNodes.end(); ++node){
+		vector<Edge*> edges = (*node)->GetEdges();
+		bool imported = nodeToGraphmlId.count(*node) != 0;
+		for(vector<Edge*>::iterator edge = edges.begin(); edge != edges.end(); ++edge){
+			if(matchedNodes.count((*edge)->GetToNode()) == 0){
+				continue;
+			}
+			map<tuple<Node*, Node*, string>, int>::iterator wanted = wantedEdges.find(make_tuple(*node, (*edge)->GetToNode(), (*edge)->GetName()));
+			if(wanted != wantedEdges.end() && wanted->second > 0){
+				wanted->second--;
+				continue;
+			}
+			// Edges from or to a node created by code are kept
+			if(!imported || nodeToGraphmlId.count((*edge)->GetToNode()) == 0){
+				continue;
+			}
+			DeleteEdge(*edge);
+			delta.removedEdges++;
+		}
+	}
+	// Create wanted edges which do not exist yet, in order of the file : both directions of a missing bidirectional edge are created together, like ImportGraphml does
+	for(vector<GraphmlEdge>::iterator xmlEdge = xmlEdges.begin(); xmlEdge != xmlEdges.end(); ++xmlEdge){
+		Node* source = iToNode[xmlEdge->source];
+		Node* target = iToNode[xmlEdge->target];
+		int& forward = wantedEdges[make_tuple(source, target, xmlEdge->name)];
+		int& backward = wantedEdges[make_tuple(target, source, xmlEdge->name)];
+		if(xmlEdge->isBidirectional && forward > 0 && backward > 0 && &forward != &backward){
+			ConnectNodes(source, target, true, xmlEdge->name);
+			forward--;
+			backward--;
+			delta.addedEdges += 2;
+			continue;
+		}
+		if(forward > 0){
+			ConnectNodes(source, target, false, xmlEdge->name);
+			forward--;
+			delta.addedEdges++;
+		}
+		if(xmlEdge->isBidirectional && backward > 0){
+			ConnectNodes(target, source, false, xmlEdge->name);
+			backward--;
+			delta.addedEdges++;
+		}
+	}
+	return delta;
+}
+
+bool Graph::ReadGraphml(string path, vector<GraphmlNode>& xmlNodesRead, vector<GraphmlEdge>& xmlEdgesRead){
+	set<string> knownIds;		// Unique indexes of the read nodes
 	TiXmlDocument file;		// XML file to read
 	// Try to open XML file
 	if(!file.LoadFile(path.c_str())){
 		cout << "[ERROR] Failed to open GraphML file \"" << path << "\" ; no node and edge as been imported" << endl;
-		return;
+		return false;
 	}
 	// Grab the root-element
 	TiXmlElement* xmlRoot = file.FirstChildElement();
 	if(xmlRoot == NULL){
 		cout << "[ERROR] Failed to load root element from GraphML file \"" << path << "\" ; no node and edge as been imported" << endl;
-		return;
+		return false;
 	}
 	// Grab the graph-element in the root-element
 	TiXmlElement* xmlGraph = FindXmlChild(xmlRoot, "graph");
 	if(xmlGraph == NULL){
 		cout << "[ERROR] Failed to load root/graph element from GraphML file \"" << path << "\" ; no node and edge as been imported" << endl;
-		return;
+		return false;
 	}
 	// Grab the node-elements in the graph-element
 	vector<TiXmlElement*> xmlNodes = FindXmlChilds(xmlGraph, "node");
 	if(xmlNodes.empty()){
 		cout << "[ERROR] Failed to load root/graph/node[] elements from GraphML file \"" << path << "\" ; no node and edge as been imported" << endl;
-		return;
+		return false;
 	}
 	// Iterate over the node-elements
 	for(vector<TiXmlElement*>::iterator xmlNode = xmlNodes.begin(); xmlNode != xmlNodes.end(); ++xmlNode){
@@ -218,9 +889,9 @@ void Graph::ImportGraphml(string path){
 		const char* name = xmlLabel->GetText();
 		const char* x = xmlGeometry->Attribute("x");
 		const char* y = xmlGeometry->Attribute("y");
+		// An empty label has no text (yEd and ExportGraphml write it this way)
 		if(name == NULL){
-			cout << "[WARNING] Failed to read name value of root/graph/node/data/y:ShapeNode/y:NodeLabel for node \"" << i << "\" from GraphML file \"" << path << "\" ; this node has been ignored" << endl;
-			continue;
+			name = "";
 		}
 		if(x == NULL){
 			cout << "[WARNING] Failed to read x attribute of root/graph/node/data/y:ShapeNode/y:Geometry for node \"" << i << "\" from GraphML file \"" << path << "\" ; this node has been ignored" << endl;
@@ -230,14 +901,20 @@ void Graph::ImportGraphml(string path){
 			cout << "[WARNING] Failed to read x attribute of root/graph/node/data/y:ShapeNode/y:Geometry for node \"" << i << "\" from GraphML file \"" << path << "\" ; this node has been ignored" << endl;
 			continue;
 		}
-		// Create the node and put it in the dictionary
-		iToNode[string(i)] = CreateNode(string(name), atof(x), atof(y));
+		// Keep the node and its unique index
+		GraphmlNode xmlNodeRead;
+		xmlNodeRead.id = i;
+		xmlNodeRead.name = name;
+		xmlNodeRead.x = atof(x);
+		xmlNodeRead.y = atof(y);
+		xmlNodesRead.push_back(xmlNodeRead);
+		knownIds.insert(xmlNodeRead.id);
 	}
 	// Grab the edge-elements in the graph-element
 	vector<TiXmlElement*> xmlEdges = FindXmlChilds(xmlGraph, "edge");
 	if(xmlEdges.empty()){
 		cout << "[WARNING] Failed to load root/graph/edge[] elements from GraphML file \"" << path << "\" ; no edge as been imported" << endl;
-		return;
+		return true;
 	}
 	// Iterate over the edge-elements
 	for(vector<TiXmlElement*>::iterator xmlEdge = xmlEdges.begin(); xmlEdge != xmlEdges.end(); ++xmlEdge){
@@ -257,11 +934,14 @@ void Graph::ImportGraphml(string path){
 			cout << "[WARNING] Failed to read target attribute of root/graph/edge for edge \"" << iEdge << "\" from GraphML file \"" << path << "\" ; this edge has been ignored" << endl;
 			continue;
 		}
-		// Find source and target node in the dictionary with their unique id
-		Node* nodeSource = iToNode[string(iSource)];
-		Node* nodeTarget = iToNode[string(iTarget)];
-		// Arrow-elements not found yet
+		// Source and target nodes have to be read nodes
+		if(knownIds.count(iSource) == 0 || knownIds.count(iTarget) == 0){
+			cout << "[WARNING] Unknown source or target node for edge \"" << iEdge << "\" from GraphML file \"" << path << "\" ; this edge has been ignored" << endl;
+			continue;
+		}
+		// Arrow-elements and label-elements not found yet
 		TiXmlElement* xmlArrows = NULL;
+		TiXmlElement* xmlLabel = NULL;
 		// Grab the data-elements in the edge-element
 		vector<TiXmlElement*> xmlDatas = FindXmlChilds(*xmlEdge, "data");
 		if(xmlDatas.size() == 0){
@@ -278,6 +958,10 @@ void Graph::ImportGraphml(string path){
 			for(vector<TiXmlElement*>::iterator xmlUnknown = xmlUnknowns.begin(); xmlUnknown != xmlUnknowns.end(); ++xmlUnknown){
 				// Grab the arrows-element in the unknown-element
 				xmlArrows = FindXmlChild(*xmlUnknown, "y:Arrows");
+				// Grab the optional label-element in the unknown-element
+				if(xmlLabel == NULL){
+					xmlLabel = FindXmlChild(*xmlUnknown, "y:EdgeLabel");
+				}
 			}
 		}
 		bool sourceToTarget = true;
@@ -294,21 +978,262 @@ void Graph::ImportGraphml(string path){
 			const char* source = xmlArrows->Attribute("source");
 			targetToSource = (source == NULL || strcmp(source, "none") != 0);
 		}
-		// If no orientation is found of two orientations are found, create a bidirectional edge and save it
+		GraphmlEdge xmlEdgeRead;
+		xmlEdgeRead.source = iSource;
+		xmlEdgeRead.target = iTarget;
+		xmlEdgeRead.name = (xmlLabel != NULL && xmlLabel->GetText() != NULL) ? xmlLabel->GetText() : "";
+		xmlEdgeRead.isBidirectional = false;
+		// If no orientation is found of two orientations are found, keep a bidirectional edge
 		if(!(sourceToTarget ^ targetToSource)){
-			ConnectNodes(nodeSource, nodeTarget, true);
+			xmlEdgeRead.isBidirectional = true;
 		}
-		// If only an orientation from source to target is found, create a unidirectional edge from source to target and save it
-		else if(sourceToTarget){
-			ConnectNodes(nodeSource, nodeTarget, false);
-		}
-		// If only an orientation from target to source is found, create a unidirectional edge from target to source and save it (possible if user create a link in yEd from a node to another and change arrows style after)
+		// If only an orientation from target to source is found, keep a unidirectional edge from target to source (possible if user create a link in yEd from a node to another and change arrows style after)
 		else if(targetToSource){
-			ConnectNodes(nodeTarget, nodeSource, false);
+			swap(xmlEdgeRead.source, xmlEdgeRead.target);
+		}
+		// Else, only an orientation from source to target is found : keep a unidirectional edge from source to target
+		xmlEdgesRead.push_back(xmlEdgeRead);
+	}
+	return true;
+}
+
+void Graph::ImportEdgeList(string path){
+	ImportEdgeList(path, ',');
+}
+
+void Graph::ImportEdgeList(string path, char separator){
+	EdgeListFormat::Load(path, separator, importThreads, *this);
+}
+
+void Graph::ImportDot(string path){
+	ImportDot(path, 1);
+}
+
+void Graph::ImportDot(string path, float scale){
+	DotFormat::Load(path, scale, *this);
+}
+
+CsrSnapshot Graph::Freeze(){
+	return CsrSnapshot(nodes);
+}
+
+void Graph::Thaw(const CsrSnapshot& snapshot){
+	const vector<uint64_t>& offsets = snapshot.GetOffsets();
+	const vector<uint32_t>& targets = snapshot.GetTargets();
+	const vector<float>& weights = snapshot.GetWeights();
+	const vector<float>& coordinates = snapshot.GetCoordinates();
+	const vector<uint8_t>& fixed = snapshot.GetFixed();
+	vector<Node*> created(snapshot.GetNodeCount());	// Created nodes, by index in the snapshot
+	nodes.reserve(nodes.size() + created.size());
+	for(size_t i = 0; i < created.size(); i++){
+		if(fixed[i]){
+			created[i] = CreateNode(snapshot.GetNodeLabel(i), coordinates[2 * i], coordinates[2 * i + 1]);
+		}
+		else{
+			created[i] = CreateNode(snapshot.GetNodeLabel(i));
+		}
+	}
+	// Edges are created in bulk : lists are sized once, and new nodes are already in the log of changed nodes
+	vector<size_t> incomingCounts(created.size(), 0);
+	for(vector<uint32_t>::const_iterator target = targets.begin(); target != targets.end(); ++target){
+		incomingCounts[*target]++;
+	}
+	for(size_t i = 0; i < created.size(); i++){
+		created[i]->edges.reserve(offsets[i + 1] - offsets[i]);
+		created[i]->incomingEdges.reserve(incomingCounts[i]);
+	}
+	for(size_t i = 0; i < created.size(); i++){
+		for(uint64_t edge = offsets[i]; edge < offsets[i + 1]; edge++){
+			Node* toNode = created[targets[edge]];
+			Edge* newEdge = new Edge(created[i], toNode, snapshot.GetEdgeLabel(edge));
+			newEdge->SetWeight(weights[edge]);
+			created[i]->edges.push_back(newEdge);
+			toNode->incomingEdges.push_back(newEdge);
+		}
+	}
+}
+
+void Graph::ExtractSubgraph(const vector<Node*>& selected, Graph& subgraph){
+	if(&subgraph == this){
+		cout << "[WARNING] Trying to extract a subgraph into the same graph ; no node has been copied" << endl;
+		return;
+	}
+	// Selected nodes are marked by dense index, so the filter is a lookup
+	vector<bool> marked(nodes.size(), false);
+	for(vector<Node*>::const_iterator node = selected.begin(); node != selected.end(); ++node){
+		if(Contains(*node)){
+			marked[(*node)->index] = true;
+		}
+	}
+	GraphView view(*this);
+	view.FilterNodes([&marked](Node* node){return marked[node->index];});
+	subgraph.Thaw(view.Freeze());
+}
+
+void Graph::ExtractSubgraph(GraphView& view, Graph& subgraph){
+	if(&view.GetGraph() != this || &subgraph == this){
+		cout << "[WARNING] Trying to extract a view of another graph, or into the same graph ; no node has been copied" << endl;
+		return;
+	}
+	subgraph.Thaw(view.Freeze());
+}
+
+vector<uint32_t> Graph::ComputeDistances(Node* source){
+	if(!Contains(source)){
+		cout << "[WARNING] Trying to compute distances from a node which is not in graph collection ; no node has been reached" << endl;
+		return vector<uint32_t>(nodes.size(), BreadthFirstSearch::UNREACHED);
+	}
+	BreadthFirstSearch search;
+	search.SetThreads(0);
+	search.Run(Freeze(), source->index);
+	return search.GetDistances();
+}
+
+vector<Node*> Graph::FindShortestPath(Node* source, Node* target){
+	vector<Node*> path;
+	if(!Contains(source) || !Contains(target)){
+		cout << "[WARNING] Trying to find a path between nodes which are not in graph collection ; no path has been found" << endl;
+		return path;
+	}
+	CsrSnapshot snapshot = Freeze();
+	ShortestPath search;
+	search.Prepare(snapshot);
+	search.RunAStar(source->index, target->index);
+	vector<uint32_t> indices = search.GetPath(target->index);
+	for(vector<uint32_t>::iterator index = indices.begin(); index != indices.end(); ++index){
+		path.push_back(nodes[*index]);
+	}
+	return path;
+}
+
+vector<uint32_t> Graph::ComputeComponents(bool strong){
+	ConnectedComponents components;
+	components.SetThreads(0);
+	if(strong){
+		components.RunStrong(Freeze());
+	}
+	else{
+		components.RunWeak(Freeze());
+	}
+	return components.GetComponents();
+}
+
+vector<Node*> Graph::SortTopologically(){
+	vector<Node*> sorted;
+	TopologicalOrder order;
+	if(!order.Run(Freeze())){
+		const vector<uint32_t>& cycle = order.GetCycle();
+		cout << "[WARNING] Trying to sort a graph with a cycle (\"" << nodes[cycle.front()]->name << "\"";
+		for(size_t i = 1; i < cycle.size(); i++){
+			cout << " -> \"" << nodes[cycle[i]]->name << "\"";
 		}
-		// Else, there is a bug in the matrix
-		else{}
+		cout << " -> \"" << nodes[cycle.front()]->name << "\") ; no node has been sorted" << endl;
+		return sorted;
+	}
+	const vector<uint32_t>& indices = order.GetOrder();
+	for(vector<uint32_t>::const_iterator index = indices.begin(); index != indices.end(); ++index){
+		sorted.push_back(nodes[*index]);
 	}
+	return sorted;
+}
+
+vector<Node*> Graph::FindCriticalPath(){
+	vector<Node*> path;
+	CsrSnapshot snapshot = Freeze();
+	TimingAnalysis timing;
+	timing.SetThreads(0);
+	if(!timing.Run(snapshot)){
+		return path;
+	}
+	vector<uint32_t> indices = timing.GetCriticalPath();
+	for(vector<uint32_t>::iterator index = indices.begin(); index != indices.end(); ++index){
+		path.push_back(nodes[*index]);
+	}
+	return path;
+}
+
+vector<double> Graph::ComputePageRank(){
+	PageRank pageRank;
+	pageRank.SetThreads(0);
+	if(!pageRank.Run(Freeze())){
+		cout << "[WARNING] PageRank has not converged after " << pageRank.GetIterations() << " iterations ; ranks are approximate" << endl;
+	}
+	return pageRank.GetRanks();
+}
+
+vector<double> Graph::ComputeBetweenness(size_t samples){
+	Betweenness betweenness;
+	betweenness.SetThreads(0);
+	betweenness.SetSamples(samples);
+	betweenness.Run(Freeze());
+	return betweenness.GetScores();
+}
+
+vector<Node*> Graph::FindNodesInBox(float minX, float minY, float maxX, float maxY){
+	PrepareSpatialIndex();
+	return spatialIndex.FindInBox(minX, minY, maxX, maxY);
+}
+
+vector<Node*> Graph::FindNodesInRadius(float x, float y, float radius){
+	PrepareSpatialIndex();
+	return spatialIndex.FindInRadius(x, y, radius);
+}
+
+vector<Node*> Graph::FindNearestNodes(float x, float y, size_t count){
+	PrepareSpatialIndex();
+	return spatialIndex.FindNearest(x, y, count);
+}
+
+Node* Graph::FindNodeAt(float x, float y, float radius){
+	vector<Node*> nearest = FindNearestNodes(x, y, 1);
+	if(nearest.empty()){
+		return NULL;
+	}
+	double dx = (double) nearest.front()->x - x;
+	double dy = (double) nearest.front()->y - y;
+	return dx * dx + dy * dy <= (double) radius * radius ? nearest.front() : NULL;
+}
+
+void Graph::ComputeLayout(){
+	ForceLayout layout;
+	layout.SetThreads(0);
+	ComputeLayout(layout);
+}
+
+void Graph::ComputeLayout(ForceLayout& layout){
+	vector<float> positions = layout.Run(Freeze());
+	for(size_t i = 0; i < nodes.size(); i++){
+		if(!nodes[i]->fixedPos){
+			nodes[i]->SetPos(positions[2 * i], positions[2 * i + 1]);
+		}
+	}
+}
+
+void Graph::Reorder(){
+	NodeOrder order;
+	Reorder(order);
+}
+
+void Graph::Reorder(NodeOrder& order){
+	order.Run(Freeze());
+	const vector<uint32_t>& indices = order.GetOrder();
+	vector<Node*> reordered(nodes.size());
+	for(size_t i = 0; i < reordered.size(); i++){
+		reordered[i] = nodes[indices[i]];
+		reordered[i]->index = i;
+	}
+	nodes.swap(reordered);
+	// The structural hash and PatchDot use unique indexes, which do not change, but ExportDot writes dense indexes
+	exportHash = 0;
+	recordedTicket = exportTicket;
+}
+
+bool Graph::SaveBinary(string path){
+	return BinaryFormat::Save(Freeze(), path);
+}
+
+bool Graph::LoadBinary(string path){
+	return BinaryFormat::Load(path, *this);
 }
 
 TiXmlElement* Graph::FindXmlChild(TiXmlElement* xmlSuper, const char* childTag){
@@ -329,3 +1254,387 @@ vector<TiXmlElement*> Graph::FindXmlChilds(TiXmlElement* xmlSuper, const char* c
 	}
 	return resultat;
 }
+
+void Graph::IndexGraphmlId(Node* node, string id){
+	// A unique index refers to only one node, and a node has only one unique index
+	unordered_map<string, Node*>::iterator previousNode = graphmlIdToNode.find(id);
+	if(previousNode != graphmlIdToNode.end()){
+		nodeToGraphmlId.erase(previousNode->second);
+	}
+	unordered_map<Node*, string>::iterator previousId = nodeToGraphmlId.find(node);
+	if(previousId != nodeToGraphmlId.end()){
+		graphmlIdToNode.erase(previousId->second);
+	}
+	graphmlIdToNode[id] = node;
+	nodeToGraphmlId[node] = id;
+}
+
+void Graph::WriteDotSection(DotWriter& fichier, bool edges, float scale, const DotCompaction* compaction, size_t& ignoredEdges){
+	unsigned threadCount = exportThreads == 0 ? max(1u, thread::hardware_concurrency()) : exportThreads;
+	// Small graphs are not worth threads
+	if(threadCount <= 1 || nodes.size() <= EXPORT_BLOCK_SIZE){
+		ignoredEdges += WriteDotRange(fichier, 0, nodes.size(), edges, scale, compaction);
+		return;
+	}
+	// Blocks of consecutive nodes with about the same number of statements : a node weighs one, plus its edges in the edge section
+	size_t totalWeight = 0;
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		totalWeight += edges ? 1 + (*node)->edges.size() : 1;
+	}
+	size_t blocksPerThread = max((size_t) 1, (totalWeight + threadCount * EXPORT_BLOCK_SIZE - 1) / (threadCount * EXPORT_BLOCK_SIZE));
+	size_t blockCount = threadCount * blocksPerThread;
+	vector<size_t> firstNodes(blockCount + 1, nodes.size());	// First node of each block
+	firstNodes[0] = 0;
+	size_t weight = 0;
+	size_t block = 1;
+	for(size_t i = 0; i < nodes.size() && block < blockCount; i++){
+		weight += edges ? 1 + nodes[i]->edges.size() : 1;
+		for(; block < blockCount && weight >= totalWeight * block / blockCount; block++){
+			firstNodes[block] = i + 1;
+		}
+	}
+	// Each thread of the pool formats its blocks in order, each block in its own buffer
+	vector<DotWriter> buffers(blockCount);
+	vector<bool> ready(blockCount, false);
+	vector<size_t> ignoredPerThread(threadCount, 0);
+	mutex readyLock;
+	condition_variable blockReady;
+	for(unsigned t = 0; t < threadCount; t++){
+		GetFormatPool().Submit([this, &buffers, &ready, &ignoredPerThread, &readyLock, &blockReady, &firstNodes, t, blocksPerThread, edges, scale, compaction](){
+			for(size_t b = t * blocksPerThread; b < (t + 1) * blocksPerThread; b++){
+				ignoredPerThread[t] += WriteDotRange(buffers[b], firstNodes[b], firstNodes[b + 1], edges, scale, compaction);
+				lock_guard<mutex> lock(readyLock);
+				ready[b] = true;
+				blockReady.notify_all();
+			}
+		});
+	}
+	// Blocks are written in order as soon as they are ready : the text is the same as a sequential export
+	for(size_t b = 0; b < blockCount; b++){
+		{
+			unique_lock<mutex> lock(readyLock);
+			blockReady.wait(lock, [&ready, b](){return ready[b];});
+		}
+		fichier.Write(string_view(buffers[b].GetData(), buffers[b].GetSize()));
+		buffers[b].Release();
+	}
+	for(unsigned t = 0; t < threadCount; t++){
+		ignoredEdges += ignoredPerThread[t];
+	}
+}
+
+WorkerPool& Graph::GetFormatPool(){
+	static WorkerPool pool(0);
+	return pool;
+}
+
+size_t Graph::WriteDotRange(DotWriter& out, size_t first, size_t last, bool edges, float scale, const DotCompaction* compaction){
+	size_t ignoredEdges = 0;
+	for(size_t i = first; i < last; i++){
+		Node* node = nodes[i];
+		// The unique index of each node is its dense index in the graph
+		if(!edges && compaction != NULL){
+			out.WriteCompactNode(i, node->name, node->fixedPos, node->x, node->y, scale);
+			continue;
+		}
+		if(!edges){
+			out.WriteNode(i, node->name, node->fixedPos, node->x, node->y, scale);
+			continue;
+		}
+		size_t sequence = compaction != NULL ? compaction->firstEdges[i] : 0;
+		for(vector<Edge*>::iterator edge = node->edges.begin(); edge != node->edges.end(); ++edge, ++sequence){
+			Node* toNode = (*edge)->GetToNode();
+			if(!Contains(toNode)){
+				ignoredEdges++;
+				continue;
+			}
+			if(compaction == NULL){
+				out.WriteEdge(i, toNode->index, (*edge)->GetName());
+				continue;
+			}
+			bool isBidirectional = compaction->pairedEdges[sequence];
+			// The edge of the pair with the greatest source index is written with the other one
+			if(isBidirectional && toNode->index < node->index){
+				continue;
+			}
+			string_view dir = isBidirectional == compaction->bidirectionalByDefault ? "" : (isBidirectional ? "both" : "forward");
+			out.WriteCompactEdge(i, toNode->index, dir, (*edge)->GetName() != compaction->label, (*edge)->GetName());
+		}
+	}
+	return ignoredEdges;
+}
+
+void Graph::PrepareCompaction(DotCompaction& compaction){
+	vector<Edge*> edges;				// All edges, in order of nodes then of their outgoing edges
+	compaction.firstEdges.resize(nodes.size());
+	for(size_t i = 0; i < nodes.size(); i++){
+		compaction.firstEdges[i] = edges.size();
+		edges.insert(edges.end(), nodes[i]->edges.begin(), nodes[i]->edges.end());
+	}
+	compaction.pairedEdges = FindReverseEdges(edges);
+	ChooseEdgeDefaults(edges, compaction);
+}
+
+void Graph::ChooseEdgeDefaults(const vector<Edge*>& edges, DotCompaction& compaction){
+	unordered_map<string_view, size_t> labelCounts;	// Number of written edges with each label
+	size_t bidirectionalCount = 0;			// Number of written pairs of reverse edges
+	size_t writtenCount = 0;			// Number of written edge statements
+	for(size_t sequence = 0; sequence < edges.size(); sequence++){
+		Node* fromNode = edges[sequence]->GetFromNode();
+		Node* toNode = edges[sequence]->GetToNode();
+		bool isBidirectional = compaction.pairedEdges[sequence];
+		if(!Contains(toNode) || (isBidirectional && toNode->index < fromNode->index)){
+			continue;
+		}
+		labelCounts[edges[sequence]->GetName()]++;
+		bidirectionalCount += isBidirectional;
+		writtenCount++;
+	}
+	compaction.bidirectionalByDefault = 2 * bidirectionalCount > writtenCount;
+	// The most frequent label is the default one (an empty label is already the default one of Graphviz)
+	size_t labelCount = labelCounts[""];
+	compaction.label.clear();
+	for(unordered_map<string_view, size_t>::iterator label = labelCounts.begin(); label != labelCounts.end(); ++label){
+		if(label->second > labelCount || (label->second == labelCount && !label->first.empty() && label->first < compaction.label)){
+			labelCount = label->second;
+			compaction.label = label->first;
+		}
+	}
+}
+
+size_t Graph::WriteDotBlock(DotWriter& out, Node* node, float scale){
+	size_t ignoredEdges = 0;
+	out.WriteNode(node->serial, node->name, node->fixedPos, node->x, node->y, scale);
+	for(vector<Edge*>::iterator edge = node->edges.begin(); edge != node->edges.end(); ++edge){
+		Node* toNode = (*edge)->GetToNode();
+		if(!Contains(toNode)){
+			ignoredEdges++;
+			continue;
+		}
+		out.WriteEdge(node->serial, toNode->serial, (*edge)->GetName());
+	}
+	return ignoredEdges;
+}
+
+size_t Graph::FindDrawingBounds(float& minX, float& minY, float& maxX, float& maxY){
+	size_t drawnNodes = 0;
+	minX = minY = maxX = maxY = 0;
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		if(!(*node)->fixedPos){
+			continue;
+		}
+		if(drawnNodes == 0){
+			minX = maxX = (*node)->x;
+			minY = maxY = (*node)->y;
+		}
+		minX = min(minX, (*node)->x);
+		maxX = max(maxX, (*node)->x);
+		minY = min(minY, (*node)->y);
+		maxY = max(maxY, (*node)->y);
+		drawnNodes++;
+	}
+	if(drawnNodes < nodes.size()){
+		cout << "[WARNING] " << nodes.size() - drawnNodes << " nodes have no fixed position ; these nodes and their edges have not been drawn (see ComputeLayout)" << endl;
+	}
+	return drawnNodes;
+}
+
+void Graph::VisitDrawnEdges(const vector<bool>& pairedEdges, size_t& ignoredEdges, const function<void(Node*, Node*, Edge*, bool)>& visit){
+	size_t sequence = 0;
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		if(!(*node)->fixedPos){
+			sequence += (*node)->edges.size();
+			continue;
+		}
+		for(vector<Edge*>::iterator edge = (*node)->edges.begin(); edge != (*node)->edges.end(); ++edge, ++sequence){
+			Node* toNode = (*edge)->GetToNode();
+			if(!Contains(toNode)){
+				ignoredEdges++;
+				continue;
+			}
+			if(!toNode->fixedPos){
+				continue;
+			}
+			bool isBidirectional = pairedEdges[sequence];
+			// The edge of the pair with the greatest source index is drawn with the other one
+			if(isBidirectional && toNode->index < (*node)->index){
+				continue;
+			}
+			visit(*node, toNode, *edge, isBidirectional);
+		}
+	}
+}
+
+vector<bool> Graph::FindReverseEdges(){
+	vector<Edge*> edges;				// All edges, in order of nodes then of their outgoing edges
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		edges.insert(edges.end(), (*node)->edges.begin(), (*node)->edges.end());
+	}
+	return FindReverseEdges(edges);
+}
+
+vector<bool> Graph::FindReverseEdges(const vector<Edge*>& edges){
+	// Edge between two nodes, whatever its direction
+	struct LinkRecord{
+		uint32_t low;		// Lowest node index
+		uint32_t high;		// Highest node index
+		const string* label;	// Label of the edge
+		size_t sequence;	// Position of the edge in order of nodes then of their edges
+		bool backward;		// If the edge goes from the highest node to the lowest one
+	};
+	vector<LinkRecord> links;
+	for(size_t sequence = 0; sequence < edges.size(); sequence++){
+		Node* fromNode = edges[sequence]->GetFromNode();
+		Node* toNode = edges[sequence]->GetToNode();
+		// Loops cannot be bidirectional
+		if(!Contains(toNode) || toNode == fromNode){
+			continue;
+		}
+		bool backward = toNode->index < fromNode->index;
+		LinkRecord link = {(uint32_t) min(toNode->index, fromNode->index), (uint32_t) max(toNode->index, fromNode->index), &edges[sequence]->GetName(), sequence, backward};
+		links.push_back(link);
+	}
+	// Sorting gathers edges between the same nodes with the same label, in their order
+	sort(links.begin(), links.end(), [](const LinkRecord& a, const LinkRecord& b){
+		if(a.low != b.low || a.high != b.high){
+			return a.low != b.low ? a.low < b.low : a.high < b.high;
+		}
+		int labels = a.label->compare(*b.label);
+		return labels != 0 ? labels < 0 : a.sequence < b.sequence;
+	});
+	// In each group, the n-th edge in a direction is paired with the n-th edge in the other direction
+	vector<bool> paired(edges.size(), false);
+	for(size_t first = 0; first < links.size(); ){
+		size_t last = first;
+		size_t forwardCount = 0;
+		size_t backwardCount = 0;
+		while(last < links.size() && links[last].low == links[first].low && links[last].high == links[first].high && *links[last].label == *links[first].label){
+			(links[last].backward ? backwardCount : forwardCount)++;
+			last++;
+		}
+		size_t pairCount = min(forwardCount, backwardCount);
+		forwardCount = backwardCount = 0;
+		for(size_t i = first; i < last; i++){
+			if((links[i].backward ? backwardCount : forwardCount)++ < pairCount){
+				paired[links[i].sequence] = true;
+			}
+		}
+		first = last;
+	}
+	return paired;
+}
+
+WorkerPool& Graph::GetExportPool(){
+	// Exports mostly wait for the disk and for Graphviz : two of them run at once
+	static WorkerPool pool(2);
+	return pool;
+}
+
+unsigned long long Graph::HashExport(const vector<string>& paths, float scale){
+	unsigned long long hash = GetStructureHash();
+	unsigned scaleBits;				// Bits of the scale
+	memcpy(&scaleBits, &scale, sizeof(scaleBits));
+	for(vector<string>::const_iterator path = paths.begin(); path != paths.end(); ++path){
+		hash = MixHash(hash, std::hash<string>()(*path));
+	}
+	return MixHash(MixHash(MixHash(hash, scaleBits), nativeRendering), compactDot);
+}
+
+void Graph::CollectAsyncExport(){
+	lock_guard<mutex> lock(asyncExport->lock);
+	if(asyncExport->ticket > recordedTicket){
+		recordedTicket = asyncExport->ticket;
+		exportHash = asyncExport->hash;
+		exportedFiles = asyncExport->files;
+	}
+}
+
+bool Graph::IsExportUpToDate(unsigned long long hash, const vector<string>& paths){
+	vector<ExportedFile> files;			// Files as they are now
+	CollectAsyncExport();
+	return exportHash != 0 && hash == exportHash && FindExportedFiles(paths, files) && files == exportedFiles;
+}
+
+void Graph::PrepareSpatialIndex(){
+	// The first search indexes all nodes, next ones only take changed nodes into account
+	if(!spatialIndex.IsBuilt()){
+		spatialIndex.Build(nodes);
+	}
+	ApplyChanges();
+}
+
+void Graph::ApplyChanges(){
+	for(vector<Node*>::iterator node = changedNodes.begin(); node != changedNodes.end(); ++node){
+		structureHash -= (*node)->hash;
+		(*node)->hash = HashNode(*node);
+		structureHash += (*node)->hash;
+		(*node)->changed = false;
+		// Only a file already written can be patched : else all nodes will be written
+		if(dotPatch.IsStarted()){
+			unpatchedNodes.insert(*node);
+		}
+		// The position may have changed : the index is only maintained once a search has built it
+		spatialIndex.Update(*node);
+	}
+	changedNodes.clear();
+}
+
+unsigned long long Graph::HashNode(Node* node){
+	unsigned positionBits[2];			// Bits of the position
+	memcpy(&positionBits[0], &node->x, sizeof(unsigned));
+	memcpy(&positionBits[1], &node->y, sizeof(unsigned));
+	unsigned long long hash = MixHash(node->serial, std::hash<string>()(node->name));
+	if(node->fixedPos){
+		hash = MixHash(MixHash(hash, positionBits[0]), positionBits[1]);
+	}
+	for(vector<Edge*>::iterator edge = node->edges.begin(); edge != node->edges.end(); ++edge){
+		hash = MixHash(MixHash(hash, (*edge)->GetToNode()->serial), std::hash<string>()((*edge)->GetName()));
+	}
+	// 0 means that the node has not been hashed
+	return hash == 0 ? 1 : hash;
+}
+
+unsigned long long Graph::MixHash(unsigned long long hash, unsigned long long value){
+	// Combination of boost::hash_combine, then finalizer of SplitMix64 so that close values give far hashes
+	hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+	hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+	return hash ^ (hash >> 31);
+}
+
+bool Graph::FindExportedFiles(const vector<string>& paths, vector<ExportedFile>& files){
+	files.clear();
+	for(vector<string>::const_iterator path = paths.begin(); path != paths.end(); ++path){
+		struct stat status;			// Size and modification time of the file
+		if(path->empty()){
+			continue;
+		}
+		if(stat(path->c_str(), &status) != 0){
+			return false;
+		}
+		ExportedFile file;
+		file.path = *path;
+		file.size = status.st_size;
+		file.modifiedSec = status.st_mtim.tv_sec;
+		file.modifiedNsec = status.st_mtim.tv_nsec;
+		files.push_back(file);
+	}
+	return true;
+}
+
+bool Graph::ExportedFile::operator==(const ExportedFile& other) const{
+	return path == other.path && size == other.size && modifiedSec == other.modifiedSec && modifiedNsec == other.modifiedNsec;
+}
+
+Node* Graph::AddNode(Node* newNode){
+	newNode->index = nodes.size();
+	newNode->serial = nextSerial++;
+	newNode->changeLog = &changedNodes;
+	nodes.push_back(newNode);
+	newNode->Touch();
+	return newNode;
+}
+
+bool Graph::Contains(Node* node){
+	return node != NULL && node->index >= 0 && (size_t) node->index < nodes.size() && nodes[node->index] == node;
+}
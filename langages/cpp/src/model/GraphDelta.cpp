@@ -0,0 +1,30 @@
+#include "../../include/model/GraphDelta.h"
+
+using namespace std;
+
+GraphDelta::GraphDelta(){
+	addedEdges = 0;
+	removedEdges = 0;
+}
+
+bool GraphDelta::IsEmpty(){
+	return addedNodes.empty() && renamedNodes.empty() && movedNodes.empty() && removedNodes.empty() && addedEdges == 0 && removedEdges == 0;
+}
+
+string GraphDelta::ToString(){
+	stringstream ss;
+	ss << "Delta : " << addedNodes.size() << " added nodes, " << renamedNodes.size() << " renamed nodes, " << movedNodes.size() << " moved nodes, " << removedNodes.size() << " removed nodes, " << addedEdges << " added edges, " << removedEdges << " removed edges";
+	for(vector<Node*>::iterator node = addedNodes.begin(); node != addedNodes.end(); ++node){
+		ss << "\n\tADDED : " << (*node)->ToString(false);
+	}
+	for(vector<Node*>::iterator node = renamedNodes.begin(); node != renamedNodes.end(); ++node){
+		ss << "\n\tRENAMED : " << (*node)->ToString(false);
+	}
+	for(vector<Node*>::iterator node = movedNodes.begin(); node != movedNodes.end(); ++node){
+		ss << "\n\tMOVED : " << (*node)->ToString(false);
+	}
+	for(vector<string>::iterator name = removedNodes.begin(); name != removedNodes.end(); ++name){
+		ss << "\n\tREMOVED : Node " << *name;
+	}
+	return ss.str();
+}
@@ -0,0 +1,127 @@
+#include "../../include/model/GraphView.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace std;
+
+GraphView::GraphView(Graph& graph) : graph(graph){
+	hasBox = false;
+	minX = minY = maxX = maxY = 0;
+}
+
+void GraphView::FilterNodes(function<bool(Node*)> keepNode){
+	nodeFilters.push_back(keepNode);
+}
+
+void GraphView::FilterEdges(function<bool(Edge*)> keepEdge){
+	edgeFilters.push_back(keepEdge);
+}
+
+void GraphView::FilterComponent(uint32_t component, bool strong){
+	vector<uint32_t> components = graph.ComputeComponents(strong);
+	// Members are kept by address : indexes of nodes change when nodes are deleted
+	shared_ptr<unordered_set<Node*> > members = make_shared<unordered_set<Node*> >();
+	for(size_t i = 0; i < components.size(); i++){
+		if(components[i] == component){
+			members->insert(graph.nodes[i]);
+		}
+	}
+	nodeFilters.push_back([members](Node* node){return members->count(node) > 0;});
+}
+
+void GraphView::FilterBox(float minX, float minY, float maxX, float maxY){
+	// Two boxes keep their intersection
+	if(hasBox){
+		minX = max(minX, this->minX);
+		minY = max(minY, this->minY);
+		maxX = min(maxX, this->maxX);
+		maxY = min(maxY, this->maxY);
+	}
+	hasBox = true;
+	this->minX = minX;
+	this->minY = minY;
+	this->maxX = maxX;
+	this->maxY = maxY;
+}
+
+bool GraphView::ContainsNode(Node* node){
+	if(!graph.Contains(node)){
+		return false;
+	}
+	if(hasBox && !(node->IsFixedPos() && node->GetX() >= minX && node->GetX() <= maxX && node->GetY() >= minY && node->GetY() <= maxY)){
+		return false;
+	}
+	for(vector<function<bool(Node*)> >::iterator keepNode = nodeFilters.begin(); keepNode != nodeFilters.end(); ++keepNode){
+		if(!(*keepNode)(node)){
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GraphView::ContainsEdge(Edge* edge){
+	return edge != NULL && ContainsNode(edge->GetFromNode()) && ContainsNode(edge->GetToNode()) && PassesEdgeFilters(edge);
+}
+
+void GraphView::VisitNodes(const function<void(Node*)>& visit){
+	// Without box, all nodes are candidates
+	if(!hasBox){
+		for(vector<Node*>::iterator node = graph.nodes.begin(); node != graph.nodes.end(); ++node){
+			if(ContainsNode(*node)){
+				visit(*node);
+			}
+		}
+		return;
+	}
+	// With a box, only the nodes found by the spatial index are candidates
+	vector<Node*> candidates = graph.FindNodesInBox(minX, minY, maxX, maxY);
+	sort(candidates.begin(), candidates.end(), [](Node* a, Node* b){return a->GetIndex() < b->GetIndex();});
+	for(vector<Node*>::iterator node = candidates.begin(); node != candidates.end(); ++node){
+		if(ContainsNode(*node)){
+			visit(*node);
+		}
+	}
+}
+
+void GraphView::VisitEdges(Node* node, const function<void(Edge*)>& visit){
+	if(!ContainsNode(node)){
+		return;
+	}
+	const vector<Edge*>& edges = node->GetEdges();
+	for(vector<Edge*>::const_iterator edge = edges.begin(); edge != edges.end(); ++edge){
+		if(ContainsNode((*edge)->GetToNode()) && PassesEdgeFilters(*edge)){
+			visit(*edge);
+		}
+	}
+}
+
+vector<Node*> GraphView::GetNodes(){
+	vector<Node*> viewNodes;
+	VisitNodes([&viewNodes](Node* node){viewNodes.push_back(node);});
+	return viewNodes;
+}
+
+vector<Edge*> GraphView::GetEdges(Node* node){
+	vector<Edge*> viewEdges;
+	VisitEdges(node, [&viewEdges](Edge* edge){viewEdges.push_back(edge);});
+	return viewEdges;
+}
+
+Graph& GraphView::GetGraph(){
+	return graph;
+}
+
+CsrSnapshot GraphView::Freeze(){
+	// Sources of frozen edges are already in the view
+	return CsrSnapshot(GetNodes(), [this](Edge* edge){return ContainsNode(edge->GetToNode()) && PassesEdgeFilters(edge);});
+}
+
+bool GraphView::PassesEdgeFilters(Edge* edge){
+	for(vector<function<bool(Edge*)> >::iterator keepEdge = edgeFilters.begin(); keepEdge != edgeFilters.end(); ++keepEdge){
+		if(!(*keepEdge)(edge)){
+			return false;
+		}
+	}
+	return true;
+}
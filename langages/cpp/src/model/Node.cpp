@@ -8,6 +8,11 @@ Node::Node() : Node(""){}
 Node::Node(string name){
 	this->name = name;
 	this->fixedPos = false;
+	this->index = -1;
+	this->serial = -1;
+	this->changeLog = NULL;
+	this->changed = false;
+	this->hash = 0;
 }
 
 Node::Node(string name, float x, float y): Node(name){
@@ -17,21 +22,32 @@ Node::Node(string name, float x, float y): Node(name){
 }
 
 Node::~Node(){
+	// Loops are removed first : deleting them would modify my list of outgoing edges while iterating over it
+	DeleteEdgesToNode(this, true);
 	// Iterate other the outgoing edges to find all neighbours
 	for(vector<Edge*>::iterator edge = edges.begin(); edge != edges.end(); ++edge){
 		// Ask neighbour to delete all edges to me and to ask me to unregister these edges from my incoming edges list
 		(*edge)->GetToNode()->DeleteEdgesToNode(this, true);
 	}
-	// Iterate other remaining incoming edges (from nodes I have not outgoing edge to)
+	// Find neighbours of remaining incoming edges (from nodes I have not outgoing edge to) : several edges may come from the same neighbour, and they are deleted at once
+	vector<Node*> sources;
 	for(vector<Edge*>::iterator edge = incomingEdges.begin(); edge != incomingEdges.end(); ++edge){
-		// Ask neighbour to delete all edges to me without asking the to unregister theses edges from my incoming edges list because I am actually iterating over them !
-		(*edge)->GetFromNode()->DeleteEdgesToNode(this, false);
+		sources.push_back((*edge)->GetFromNode());
 	}
-	// Now the only remaining edges are mine
-	// Clearing list of edges calls destruction of the edges, but we have to call manually shrink to reduce memory used by the empty list
+	sort(sources.begin(), sources.end());
+	sources.erase(unique(sources.begin(), sources.end()), sources.end());
+	for(vector<Node*>::iterator source = sources.begin(); source != sources.end(); ++source){
+		// Ask neighbour to delete all edges to me without asking the to unregister theses edges from my incoming edges list because it is cleared below
+		(*source)->DeleteEdgesToNode(this, false);
+	}
+	// Now the only remaining edges are mine : edges are created in node context, they have to be deleted here
+	for(vector<Edge*>::iterator edge = edges.begin(); edge != edges.end(); ++edge){
+		delete *edge;
+	}
+	// We have to call manually shrink to reduce memory used by the empty list
 	edges.clear();
 	edges.shrink_to_fit();
-	// Clearing list of edges calls destruction of the edges, but we have to call manually shrink to reduce memory used by the empty list
+	// Incoming edges have been deleted by their source node, but we have to call manually shrink to reduce memory used by the empty list
 	incomingEdges.clear();
 	incomingEdges.shrink_to_fit();
 }
@@ -58,6 +74,7 @@ vector<Edge*> Node::ConnectToNode(Node* neighbourNode, bool isBidirectional, str
 	// Create an edge from me to the other node
 	Edge* newEdge = new Edge(this, neighbourNode, edgeName);
 	edges.push_back(newEdge);
+	Touch();
 	// Register this edge to the list of incoming edges from the point of view of the other node
 	neighbourNode->incomingEdges.push_back(newEdge);
 	resultat.push_back(newEdge);
@@ -89,6 +106,7 @@ void Node::DeleteEdgesToNode(Node* notNeighbourAnymore, bool unregisterReverseIn
 		// Edges are created in node context. They have to be deleted here.
 		delete *edge;
 		edge = edges.erase(edge);
+		Touch();
 	}
 	// Iterate over incoming edges
 	for(vector<Edge*>::iterator edge = incomingEdges.begin(); edge != incomingEdges.end();){
@@ -120,6 +138,7 @@ void Node::DeleteEdge(Edge* notEdgeAnymore, bool removeAllReverses){
 	// Edges are created in node context. They have to be deleted here.
 	delete notEdgeAnymore;
 	edges.erase(edge);
+	Touch();
 }
 
 void Node::DeleteEdge(Edge* notEdgeAnymore){
@@ -137,6 +156,13 @@ void Node::UnregisterIncomingEdge(Edge* edge){
 	incomingEdges.erase(incomingEdge);
 }
 
+void Node::Touch(){
+	if(changeLog != NULL && !changed){
+		changed = true;
+		changeLog->push_back(this);
+	}
+}
+
 string Node::ToString(){
 	return ToString(false);
 }
@@ -172,8 +198,21 @@ string Node::ToDot(int i, float scale){
 	return ss.str();
 }
 
-string Node::GetName(){return name;}
+const string& Node::GetName(){return name;}
 float Node::GetX(){return x;}
 float Node::GetY(){return y;}
-vector<Edge*> Node::GetEdges(){return edges;}
-bool Node::IsFixedPos(){return fixedPos;}
\ No newline at end of file
+const vector<Edge*>& Node::GetEdges(){return edges;}
+int Node::GetIndex(){return index;}
+bool Node::IsFixedPos(){return fixedPos;}
+
+void Node::SetName(string name){
+	this->name = name;
+	Touch();
+}
+
+void Node::SetPos(float x, float y){
+	this->x = x;
+	this->y = y;
+	this->fixedPos = true;
+	Touch();
+}
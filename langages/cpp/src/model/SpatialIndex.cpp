@@ -0,0 +1,291 @@
+#include "../../include/model/SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+using namespace std;
+
+// Average number of nodes wanted in a cell
+static const size_t NODES_PER_CELL = 4;
+
+// Lowest number of entries of a cell above which the grid is built again
+static const size_t MIN_CROWD_LIMIT = 64;
+
+// Greatest cell coordinate : farther positions share the border cells
+static const int64_t MAX_CELL = 1 << 30;
+
+SpatialIndex::SpatialIndex(){
+	cellSize = 1;
+	Clear();
+}
+
+void SpatialIndex::Build(const vector<Node*>& nodes){
+	vector<Entry> entries;
+	for(vector<Node*>::const_iterator node = nodes.begin(); node != nodes.end(); ++node){
+		if((*node)->IsFixedPos()){
+			Entry entry = {*node, (*node)->GetX(), (*node)->GetY()};
+			entries.push_back(entry);
+		}
+	}
+	Rebuild(entries);
+	built = true;
+}
+
+void SpatialIndex::Update(Node* node){
+	if(!built){
+		return;
+	}
+	if(!node->IsFixedPos()){
+		Remove(node);
+		return;
+	}
+	Entry entry = {node, node->GetX(), node->GetY()};
+	unordered_map<Node*, uint64_t>::iterator indexed = nodeCells.find(node);
+	// A node staying in its cell only gets its new position
+	if(indexed != nodeCells.end() && indexed->second == CellKey(ToCell(entry.x), ToCell(entry.y))){
+		vector<Entry>& cell = cells[indexed->second];
+		for(vector<Entry>::iterator other = cell.begin(); other != cell.end(); ++other){
+			if(other->node == node){
+				*other = entry;
+				break;
+			}
+		}
+		return;
+	}
+	Remove(node);
+	Insert(entry);
+}
+
+void SpatialIndex::Remove(Node* node){
+	unordered_map<Node*, uint64_t>::iterator indexed = nodeCells.find(node);
+	if(indexed == nodeCells.end()){
+		return;
+	}
+	unordered_map<uint64_t, vector<Entry> >::iterator cell = cells.find(indexed->second);
+	for(vector<Entry>::iterator entry = cell->second.begin(); entry != cell->second.end(); ++entry){
+		if(entry->node == node){
+			*entry = cell->second.back();
+			cell->second.pop_back();
+			break;
+		}
+	}
+	if(cell->second.empty()){
+		cells.erase(cell);
+	}
+	nodeCells.erase(indexed);
+}
+
+void SpatialIndex::Clear(){
+	cells.clear();
+	nodeCells.clear();
+	built = false;
+	builtCount = 0;
+	crowdLimit = MIN_CROWD_LIMIT;
+	crowded = false;
+	minColumn = minRow = (int32_t) MAX_CELL;
+	maxColumn = maxRow = (int32_t) -MAX_CELL;
+}
+
+bool SpatialIndex::IsBuilt(){
+	return built;
+}
+
+size_t SpatialIndex::GetSize(){
+	return nodeCells.size();
+}
+
+vector<Node*> SpatialIndex::FindInBox(float minX, float minY, float maxX, float maxY){
+	vector<Node*> found;
+	RebuildIfNeeded();
+	if(!(minX <= maxX && minY <= maxY) || cells.empty()){
+		return found;
+	}
+	int64_t firstColumn = max((int64_t) ToCell(minX), (int64_t) minColumn);
+	int64_t lastColumn = min((int64_t) ToCell(maxX), (int64_t) maxColumn);
+	int64_t firstRow = max((int64_t) ToCell(minY), (int64_t) minRow);
+	int64_t lastRow = min((int64_t) ToCell(maxY), (int64_t) maxRow);
+	if(firstColumn > lastColumn || firstRow > lastRow){
+		return found;
+	}
+	// A box covering more cells than the non-empty ones is faster to check cell by cell
+	if((uint64_t) (lastColumn - firstColumn + 1) * (uint64_t) (lastRow - firstRow + 1) > cells.size()){
+		for(unordered_map<uint64_t, vector<Entry> >::iterator cell = cells.begin(); cell != cells.end(); ++cell){
+			for(vector<Entry>::iterator entry = cell->second.begin(); entry != cell->second.end(); ++entry){
+				if(entry->x >= minX && entry->x <= maxX && entry->y >= minY && entry->y <= maxY){
+					found.push_back(entry->node);
+				}
+			}
+		}
+		return found;
+	}
+	for(int64_t row = firstRow; row <= lastRow; row++){
+		for(int64_t column = firstColumn; column <= lastColumn; column++){
+			unordered_map<uint64_t, vector<Entry> >::iterator cell = cells.find(CellKey(column, row));
+			if(cell == cells.end()){
+				continue;
+			}
+			for(vector<Entry>::iterator entry = cell->second.begin(); entry != cell->second.end(); ++entry){
+				if(entry->x >= minX && entry->x <= maxX && entry->y >= minY && entry->y <= maxY){
+					found.push_back(entry->node);
+				}
+			}
+		}
+	}
+	return found;
+}
+
+vector<Node*> SpatialIndex::FindInRadius(float x, float y, float radius){
+	vector<Node*> found = FindInBox(x - radius, y - radius, x + radius, y + radius);
+	double limit = (double) radius * radius;	// Greatest squared distance
+	found.erase(remove_if(found.begin(), found.end(), [x, y, limit](Node* node){
+		double dx = (double) node->GetX() - x;
+		double dy = (double) node->GetY() - y;
+		return dx * dx + dy * dy > limit;
+	}), found.end());
+	return found;
+}
+
+vector<Node*> SpatialIndex::FindNearest(float x, float y, size_t count){
+	vector<Node*> found;
+	RebuildIfNeeded();
+	if(count == 0 || cells.empty() || std::isnan(x) || std::isnan(y)){
+		return found;
+	}
+	priority_queue<pair<double, Node*> > nearest;	// Best nodes so far, the farthest on top
+	// Keep the nodes of a cell which are nearer than the farthest best node
+	function<void(int64_t, int64_t)> check = [this, &nearest, x, y, count](int64_t column, int64_t row){
+		unordered_map<uint64_t, vector<Entry> >::iterator cell = cells.find(CellKey(column, row));
+		if(cell == cells.end()){
+			return;
+		}
+		for(vector<Entry>::iterator entry = cell->second.begin(); entry != cell->second.end(); ++entry){
+			double dx = (double) entry->x - x;
+			double dy = (double) entry->y - y;
+			double distance = dx * dx + dy * dy;
+			if(nearest.size() < count){
+				nearest.push(make_pair(distance, entry->node));
+			}
+			else if(distance < nearest.top().first){
+				nearest.pop();
+				nearest.push(make_pair(distance, entry->node));
+			}
+		}
+	};
+	int64_t column = ToCell(x);
+	int64_t row = ToCell(y);
+	// Rings before the first one reaching a used cell are empty
+	int64_t ring = max((int64_t) 0, max(max(minColumn - column, column - maxColumn), max(minRow - row, row - maxRow)));
+	for(; ; ring++){
+		int64_t firstColumn = max(column - ring, (int64_t) minColumn);
+		int64_t lastColumn = min(column + ring, (int64_t) maxColumn);
+		for(int64_t r = max(row - ring, (int64_t) minRow); r <= min(row + ring, (int64_t) maxRow); r++){
+			if(r == row - ring || r == row + ring){
+				for(int64_t c = firstColumn; c <= lastColumn; c++){
+					check(c, r);
+				}
+				continue;
+			}
+			// Inner rows of the ring only have their two border cells
+			if(column - ring >= minColumn){
+				check(column - ring, r);
+			}
+			if(ring > 0 && column + ring <= maxColumn){
+				check(column + ring, r);
+			}
+		}
+		// All used cells have been checked
+		if(column - ring <= minColumn && column + ring >= maxColumn && row - ring <= minRow && row + ring >= maxRow){
+			break;
+		}
+		// Nodes of next rings are at least as far as the border of the checked square
+		double border = min(min(x - (double) (column - ring) * cellSize, (double) (column + ring + 1) * cellSize - x), min(y - (double) (row - ring) * cellSize, (double) (row + ring + 1) * cellSize - y));
+		if(nearest.size() == count && border > 0 && border * border >= nearest.top().first){
+			break;
+		}
+	}
+	found.resize(nearest.size());
+	for(size_t i = found.size(); i > 0; i--){
+		found[i - 1] = nearest.top().second;
+		nearest.pop();
+	}
+	return found;
+}
+
+int32_t SpatialIndex::ToCell(float value){
+	double cell = floor((double) value / cellSize);
+	if(!(cell > -MAX_CELL)){
+		return (int32_t) -MAX_CELL;
+	}
+	return (int32_t) min(cell, (double) MAX_CELL);
+}
+
+uint64_t SpatialIndex::CellKey(int32_t column, int32_t row){
+	return ((uint64_t) (uint32_t) column << 32) | (uint32_t) row;
+}
+
+void SpatialIndex::Insert(const Entry& entry){
+	int32_t column = ToCell(entry.x);
+	int32_t row = ToCell(entry.y);
+	uint64_t key = CellKey(column, row);
+	vector<Entry>& cell = cells[key];
+	cell.push_back(entry);
+	nodeCells[entry.node] = key;
+	minColumn = min(minColumn, column);
+	maxColumn = max(maxColumn, column);
+	minRow = min(minRow, row);
+	maxRow = max(maxRow, row);
+	if(cell.size() > crowdLimit){
+		crowded = true;
+	}
+}
+
+void SpatialIndex::Rebuild(const vector<Entry>& entries){
+	float minX = 0, minY = 0, maxX = 0, maxY = 0;	// Bounds of the entries
+	for(vector<Entry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry){
+		if(entry == entries.begin()){
+			minX = maxX = entry->x;
+			minY = maxY = entry->y;
+		}
+		minX = min(minX, entry->x);
+		maxX = max(maxX, entry->x);
+		minY = min(minY, entry->y);
+		maxY = max(maxY, entry->y);
+	}
+	// Square cells holding a few nodes if they were spread evenly, nodes on a line included
+	double width = (double) maxX - minX;
+	double height = (double) maxY - minY;
+	double cellCount = max((size_t) 1, entries.size() / NODES_PER_CELL);
+	double size = max(sqrt(width * height / cellCount), max(width, height) / cellCount);
+	// Cells cannot be so small that coordinates reach the limit
+	size = max(size, max(max(fabs(minX), fabs(maxX)), max(fabs(minY), fabs(maxY))) / (double) MAX_CELL);
+	cellSize = size > 0 && std::isfinite(size) ? size : 1;
+	bool wasBuilt = built;
+	Clear();
+	built = wasBuilt;
+	builtCount = entries.size();
+	cells.reserve(entries.size() / NODES_PER_CELL + 1);
+	nodeCells.reserve(entries.size());
+	size_t largest = 0;				// Entries of the most crowded cell
+	for(vector<Entry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry){
+		Insert(*entry);
+		largest = max(largest, cells[nodeCells[entry->node]].size());
+	}
+	// Nodes at the same place cannot be split : they must not make the grid built again and again
+	crowdLimit = max(MIN_CROWD_LIMIT, 2 * largest);
+	crowded = false;
+}
+
+void SpatialIndex::RebuildIfNeeded(){
+	size_t count = nodeCells.size();
+	if(!built || !(crowded || count > 2 * builtCount + MIN_CROWD_LIMIT || count < builtCount / 4)){
+		return;
+	}
+	vector<Entry> entries;
+	entries.reserve(count);
+	for(unordered_map<uint64_t, vector<Entry> >::iterator cell = cells.begin(); cell != cells.end(); ++cell){
+		entries.insert(entries.end(), cell->second.begin(), cell->second.end());
+	}
+	Rebuild(entries);
+}
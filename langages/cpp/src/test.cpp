@@ -1,6 +1,11 @@
 #include "../include/model/Graph.h"
+#include "../include/model/GraphView.h"
+#include "../include/algo/BreadthFirstSearch.h"
+#include "../include/algo/GraphGenerator.h"
+#include "../include/algo/NodeOrder.h"
 
 #include <filesystem>
+#include <math.h>
 
 using namespace std;
 
@@ -8,8 +13,205 @@ string ForgePath(filesystem::path path, string filename, string extension){
 	return (path / filename).string() + "." + extension;
 }
 
-void ExportFreePng(Graph graph, filesystem::path path, string filename){
+void ExportFreePng(Graph& graph, filesystem::path path, string filename){
 	graph.ExportDot(ForgePath(path, filename, "dot"), ForgePath(path, filename, "png"), 0);
+	// Same graph kept up to date in one file : only changed nodes are rewritten
+	graph.PatchDot(ForgePath(path, "scratch", "dot"));
+}
+
+// Print a check which has failed
+bool Check(bool condition, string what){
+	if(!condition){
+		cout << "[ERROR] " << what << " ; the result is not the expected one" << endl;
+	}
+	return condition;
+}
+
+// Labels of nodes, separated by spaces
+string JoinNames(const vector<Node*>& nodes){
+	string names;
+	for(vector<Node*>::const_iterator node = nodes.begin(); node != nodes.end(); ++node){
+		names += (names.empty() ? "" : " ") + (*node)->GetName();
+	}
+	return names;
+}
+
+// Number of outgoing edges of all nodes
+size_t CountEdges(Graph& graph){
+	size_t count = 0;
+	vector<Node*> nodes = graph.GetNodes();
+	for(vector<Node*>::iterator node = nodes.begin(); node != nodes.end(); ++node){
+		count += (*node)->GetEdges().size();
+	}
+	return count;
+}
+
+// Save and load the native binary format, then read an edge list with quoted fields
+bool CheckFormats(filesystem::path pathIn, filesystem::path pathOut){
+	Graph graph;
+	graph.ImportGraphml(ForgePath(pathIn, "simple", "graphml"));
+	Graph loaded;
+	bool success = Check(graph.SaveBinary(ForgePath(pathOut, "simple", "bin")) && loaded.LoadBinary(ForgePath(pathOut, "simple", "bin")) && loaded.ToString() == graph.ToString(), "Binary save and load");
+	filesystem::remove(ForgePath(pathOut, "simple", "bin"));
+	Graph edges;
+	edges.SetImportThreads(2);
+	edges.ImportEdgeList(ForgePath(pathIn, "edges", "csv"));
+	vector<Node*> nodes = edges.GetNodes();
+	success = Check(JoinNames(nodes) == "A B C,D D E \"quoted\"" && CountEdges(edges) == 5 && nodes[2]->GetEdges().size() == 1 && nodes[2]->GetEdges()[0]->GetName() == "second, quoted", "Edge list import") && success;
+	return Check(nodes[4]->GetEdges().size() == 1 && nodes[4]->GetEdges()[0]->GetName() == "say \"hi\"", "Edge list doubled quotes") && success;
+}
+
+// Merge GraphML files into nodes and edges created by code, which have to be kept
+bool CheckMerge(filesystem::path pathIn, filesystem::path pathOut){
+	Graph graph;
+	Node* nodeA = graph.CreateNode("A");
+	Node* nodeB = graph.CreateNode("B");
+	graph.ConnectNodes(nodeB, nodeA, false, "by code");
+	GraphDelta delta = graph.MergeGraphml(ForgePath(pathIn, "simple", "graphml"));
+	bool success = Check(delta.addedNodes.size() == 3 && delta.removedEdges == 0 && nodeB->GetEdges().size() == 2, "GraphML merge into code nodes");
+	// Same file without node A, merged by label : A has been created by code, so it stays
+	Graph other;
+	other.ImportGraphml(ForgePath(pathIn, "simple", "graphml"));
+	other.DeleteNode(other.GetNodes()[0]);
+	other.ExportGraphml(ForgePath(pathOut, "merged", "graphml"));
+	delta = graph.MergeGraphml(ForgePath(pathOut, "merged", "graphml"), true, true);
+	filesystem::remove(ForgePath(pathOut, "merged", "graphml"));
+	return Check(delta.removedNodes.empty() && graph.GetNodes().size() == 5 && nodeB->GetEdges().size() == 2, "GraphML merge keeps code nodes") && success;
+}
+
+// Export labels with quotes and backslashes to DOT, then check that importing the file gives them back
+bool CheckDotEscaping(filesystem::path path){
+	vector<string> labels = {"say \"hi\"", "ends with \\", "\\\"", "two\\\\", "line\\nbreak"};
+	Graph graph;
+	for(vector<string>::iterator label = labels.begin(); label != labels.end(); ++label){
+		graph.CreateNode(*label);
+	}
+	vector<Node*> nodes = graph.GetNodes();
+	for(size_t i = 0; i + 1 < nodes.size(); i++){
+		graph.ConnectNodes(nodes[i], nodes[i + 1], false, labels[i + 1]);
+	}
+	graph.ExportDot(ForgePath(path, "escaped", "dot"));
+	Graph imported;
+	imported.ImportDot(ForgePath(path, "escaped", "dot"));
+	vector<Node*> importedNodes = imported.GetNodes();
+	bool success = importedNodes.size() == labels.size();
+	for(size_t i = 0; success && i < labels.size(); i++){
+		success = importedNodes[i]->GetName() == labels[i];
+		success = success && (i + 1 == labels.size() || (importedNodes[i]->GetEdges().size() == 1 && importedNodes[i]->GetEdges()[0]->GetName() == labels[i + 1]));
+	}
+	if(!success){
+		cout << "[ERROR] Labels with quotes or backslashes have changed through a DOT export and import" << endl;
+	}
+	return success;
+}
+
+// Force-directed layout of a free triangle
+bool CheckLayout(){
+	Graph graph;
+	Node* nodeA = graph.CreateNode("A");
+	Node* nodeB = graph.CreateNode("B");
+	Node* nodeC = graph.CreateNode("C");
+	graph.ConnectNodes(nodeA, nodeB, false);
+	graph.ConnectNodes(nodeB, nodeC, false);
+	graph.ConnectNodes(nodeC, nodeA, false);
+	graph.ComputeLayout();
+	return Check(nodeA->IsFixedPos() && nodeB->IsFixedPos() && nodeC->IsFixedPos() && (nodeA->GetX() != nodeB->GetX() || nodeA->GetY() != nodeB->GetY()), "Force-directed layout");
+}
+
+// Distances, shortest path and components of small graphs
+bool CheckPaths(){
+	Graph graph;
+	Node* nodeA = graph.CreateNode("A", 0, 0);
+	Node* nodeB = graph.CreateNode("B", 1, 0);
+	Node* nodeC = graph.CreateNode("C", 2, 0);
+	graph.CreateNode("D", 3, 0);
+	graph.ConnectNodes(nodeA, nodeB, false);
+	graph.ConnectNodes(nodeB, nodeC, false);
+	graph.ConnectNodes(nodeA, nodeC, false)[0]->SetWeight(5);
+	vector<uint32_t> distances = graph.ComputeDistances(nodeA);
+	bool success = Check(distances == vector<uint32_t>({0, 1, 1, BreadthFirstSearch::UNREACHED}), "Breadth-first search");
+	success = Check(JoinNames(graph.FindShortestPath(nodeA, nodeC)) == "A B C" && graph.FindShortestPath(nodeC, nodeA).empty(), "Shortest path") && success;
+	// A and B reach each other, C only follows them
+	graph.ConnectNodes(nodeB, nodeA, false);
+	vector<uint32_t> weak = graph.ComputeComponents(false);
+	vector<uint32_t> strong = graph.ComputeComponents(true);
+	success = Check(weak[0] == weak[1] && weak[1] == weak[2] && weak[2] != weak[3], "Weak components") && success;
+	return Check(strong[0] == strong[1] && strong[1] != strong[2] && strong[2] != strong[3] && strong[1] != strong[3], "Strong components") && success;
+}
+
+// Topological order, critical path and cycle detection
+bool CheckTiming(){
+	Graph graph;
+	Node* nodeA = graph.CreateNode("A");
+	Node* nodeB = graph.CreateNode("B");
+	Node* nodeC = graph.CreateNode("C");
+	Node* nodeD = graph.CreateNode("D");
+	graph.ConnectNodes(nodeC, nodeD, false);
+	graph.ConnectNodes(nodeA, nodeB, false);
+	graph.ConnectNodes(nodeA, nodeC, false)[0]->SetWeight(3);
+	graph.ConnectNodes(nodeB, nodeD, false);
+	bool success = Check(JoinNames(graph.SortTopologically()) == "A B C D", "Topological order");
+	success = Check(JoinNames(graph.FindCriticalPath()) == "A C D", "Critical path") && success;
+	graph.ConnectNodes(nodeD, nodeA, false);
+	return Check(graph.SortTopologically().empty(), "Cycle detection") && success;
+}
+
+// Box, radius, nearest and point queries on positioned nodes, then after a move
+bool CheckSpatialIndex(){
+	Graph graph;
+	graph.CreateNode("NW", 0, 0);
+	graph.CreateNode("NE", 10, 0);
+	graph.CreateNode("SW", 0, 10);
+	Node* nodeSE = graph.CreateNode("SE", 10, 10);
+	graph.CreateNode("Center", 5, 5);
+	graph.CreateNode("Free");
+	bool success = Check(graph.FindNodesInBox(4, 4, 11, 11).size() == 2 && graph.FindNodesInRadius(0, 0, 10.5).size() == 4, "Spatial range queries");
+	success = Check(JoinNames(graph.FindNearestNodes(9, 8, 2)) == "SE Center" && graph.FindNodeAt(0.5, 0.5, 1)->GetName() == "NW" && graph.FindNodeAt(2, 2, 1) == NULL, "Spatial nearest queries") && success;
+	nodeSE->SetPos(1, 1);
+	return Check(graph.FindNodesInBox(4, 4, 11, 11).size() == 1 && graph.FindNodeAt(1, 1, 0.5) == nodeSE, "Spatial index update") && success;
+}
+
+// PageRank of a cycle and betweenness of a chain
+bool CheckCentrality(){
+	Graph graph;
+	Node* nodeA = graph.CreateNode("A");
+	Node* nodeB = graph.CreateNode("B");
+	Node* nodeC = graph.CreateNode("C");
+	graph.ConnectNodes(nodeA, nodeB, false);
+	graph.ConnectNodes(nodeB, nodeC, false);
+	bool success = Check(graph.ComputeBetweenness(0) == vector<double>({0, 1, 0}), "Betweenness");
+	graph.ConnectNodes(nodeC, nodeA, false);
+	vector<double> ranks = graph.ComputePageRank();
+	return Check(ranks.size() == 3 && fabs(ranks[0] - 1.0 / 3) < 1e-6 && fabs(ranks[1] - 1.0 / 3) < 1e-6 && fabs(ranks[2] - 1.0 / 3) < 1e-6, "PageRank") && success;
+}
+
+// Filtered view, extracted subgraph, reordering and generators on a grid
+bool CheckViews(filesystem::path path){
+	GraphGenerator generator;
+	generator.SetSeed(1);
+	generator.SetShuffle(true);
+	CsrSnapshot grid = generator.Grid(4, 3);
+	CsrSnapshot same = generator.Grid(4, 3);
+	bool success = Check(grid.GetNodeCount() == 12 && grid.GetEdgeCount() == 34 && grid.GetTargets() == same.GetTargets() && grid.GetCoordinates() == same.GetCoordinates(), "Seeded grid generator");
+	Graph graph;
+	graph.Thaw(grid);
+	// The left half of the grid is 2 columns of 3 nodes, linked both ways
+	GraphView view(graph);
+	view.FilterBox(0, 0, 400, 1000);
+	Graph half;
+	graph.ExtractSubgraph(view, half);
+	success = Check(view.GetNodes().size() == 6 && half.GetNodes().size() == 6 && CountEdges(half) == 14, "Filtered view and subgraph") && success;
+	// Compact text of the view pairs its reverse edges, and reads back the same
+	graph.ExportDot(view, ForgePath(path, "half", "dot"));
+	graph.SetCompactDot(true);
+	graph.ExportDot(view, ForgePath(path, "halfCompact", "dot"));
+	graph.SetCompactDot(false);
+	Graph imported;
+	imported.ImportDot(ForgePath(path, "halfCompact", "dot"));
+	success = Check(imported.GetNodes().size() == 6 && CountEdges(imported) == 14 && filesystem::file_size(ForgePath(path, "halfCompact", "dot")) < filesystem::file_size(ForgePath(path, "half", "dot")), "Compact view export") && success;
+	double gap = NodeOrder::ComputeAverageGap(graph.Freeze(), vector<uint32_t>());
+	graph.Reorder();
+	return Check(graph.GetNodes().size() == 12 && CountEdges(graph) == 34 && NodeOrder::ComputeAverageGap(graph.Freeze(), vector<uint32_t>()) < gap, "Reordering") && success;
 }
 
 int main(int argc, char* argv[]){
@@ -20,6 +222,22 @@ int main(int argc, char* argv[]){
 	graph.ImportGraphml(ForgePath(pathIn, "simple", "graphml"));
 	graph.ExportDot(ForgePath(pathOut, "simpleFixed", "dot"), ForgePath(pathOut, "simpleFixed", "png"), ForgePath(pathOut, "simpleFixed", "svg"), 0.02);
 	graph.ExportDot(ForgePath(pathOut, "simpleFree", "dot"), ForgePath(pathOut, "simpleFree", "png"), ForgePath(pathOut, "simpleFree", "svg"), 0);
+	graph.ExportGraphml(ForgePath(pathOut, "simple", "graphml"));
+	graph.SetCompactDot(true);
+	graph.ExportDot(ForgePath(pathOut, "simpleCompact", "dot"), 0.02);
+	graph.SetCompactDot(false);
+	graph.SetNativeRendering(true);
+	graph.ExportDot("", ForgePath(pathOut, "simpleNative", "png"), ForgePath(pathOut, "simpleNative", "svg"), 0.02);
+	graph.SetNativeRendering(false);
+	bool success = CheckFormats(pathIn, pathOut);
+	success = CheckMerge(pathIn, pathOut) && success;
+	success = CheckDotEscaping(pathOut) && success;
+	success = CheckLayout() && success;
+	success = CheckPaths() && success;
+	success = CheckTiming() && success;
+	success = CheckSpatialIndex() && success;
+	success = CheckCentrality() && success;
+	success = CheckViews(pathOut) && success;
 
 	graph.Clear();
 	ExportFreePng(graph, pathOut, "scratch00");
@@ -65,5 +283,5 @@ int main(int argc, char* argv[]){
 	ExportFreePng(graph, pathOut, "scratch20");
 	graph.DeleteNode(nodeC);
 	ExportFreePng(graph, pathOut, "scratch21");
-	return 0;
+	return success ? 0 : 1;
 }
\ No newline at end of file